@@ -49,6 +49,7 @@ function testcase()
     TestBp:test(gworld,gactor)
 
     TestMap = require 'TestMap'
+    TestSet = require 'TestSet'
     TestArray = require 'TestArray'
     TestActor = require 'TestActor'
 
@@ -61,14 +62,31 @@ function testcase()
 end
 
 local tt=0
+-- cycles of gc scheduler when garbage is made, and frames since then
+local gcCycles
+local gcFrames=0
 function update(dt)
     tt=tt+dt
     
     TestActor.update(tt,gactor)
     TestArray.update(tt)
     TestMap.update(tt)
+    TestSet.update(tt)
     TestBp:update(tt)
 
+    -- gc scheduler runs in tick of state, a cycle must finish after garbage is made
+    local gs=slua.gcStats()
+    if not gcCycles then
+        gcCycles=gs.cycles
+        gcFrames=0
+        for i=1,10000 do local t={i} end
+    elseif gs.cycles>gcCycles then
+        gcCycles=nil
+    else
+        gcFrames=gcFrames+1
+        assert(gcFrames<600,"gc cycle isn't finished by scheduler")
+    end
+
     -- test weak ptr is alive?
     if slua.isValid(weakptr) then
         print("weak ptr",weakptr,weakptr:GetClass())
@@ -29,6 +29,26 @@ assert(arr:Get(1)==2028)
 assert(arr:Num()==9)
 print('array<int> test successful')
 
+-- bulk convert between array and table
+local tbl=arr:ToTable()
+assert(#tbl==arr:Num() and tbl[2]==2028)
+local part=arr:ToTable(1,2)
+assert(#part==2 and part[1]==2028)
+assert(arr:FromTable({5,6,7})==3)
+assert(arr:Append({8,9})==5)
+assert(arr:Get(0)==5 and arr:Get(4)==9)
+print('array bulk convert test successful')
+
+-- typed view share memory with array
+local view=arr:View()
+assert(#view==5 and view[0]==5)
+view[1]=100
+assert(arr:Get(1)==100)
+arr:Add(10)
+assert(#view==6 and view[5]==10)
+assert(not pcall(function() return view[6] end))
+print('array view test successful')
+
 -- test array<fstring>
 local arr=t:GetArrayStr()
 assert(arr:Num()==3)
@@ -66,6 +86,12 @@ assert(t.strs:Get(0)=="1")
 strs:Clear()
 assert(t.strs:Num()==0)
 
+-- array owned by object is cached by address
+local _,_,hits=slua.objectCacheStats()
+assert(rawequal(t.strs,strs))
+local size,lookups,hits2=slua.objectCacheStats()
+assert(hits2>hits and size>0 and lookups>=hits2)
+
 TestArray={}
 
 function TestArray.update()
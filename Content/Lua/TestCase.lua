@@ -15,6 +15,41 @@ function RemoveAAA()
 end
 
 t:TestAAA("abc AAAA")
+-- removing last listener in broadcast unbinds dispatcher
+assert(not t:IsAAABound())
+
+-- listeners are called in order of Add,
+-- listener removed in broadcast isn't called, listener added in broadcast is called from next broadcast
+local calls = {}
+local h1, h2, h3, h4
+h1 = t.OnTestAAA:Add(function(s) table.insert(calls, "1"..s) end)
+h2 = t.OnTestAAA:Add(function(s)
+    table.insert(calls, "2"..s)
+    if h3 then
+        t.OnTestAAA:Remove(h3)
+        h3 = nil
+    end
+    if not h4 then
+        h4 = t.OnTestAAA:Add(function(s) table.insert(calls, "4"..s) end)
+    end
+end)
+h3 = t.OnTestAAA:Add(function(s) table.insert(calls, "3"..s) end)
+assert(t:IsAAABound())
+t:TestAAA("a")
+assert(table.concat(calls, ",") == "1a,2a")
+calls = {}
+t:TestAAA("b")
+assert(table.concat(calls, ",") == "1b,2b,4b")
+
+-- dispatcher is unbound only when last listener is removed
+t.OnTestAAA:Remove(h1)
+t.OnTestAAA:Remove(h2)
+assert(t:IsAAABound())
+t.OnTestAAA:Remove(h4)
+assert(not t:IsAAABound())
+calls = {}
+t:TestAAA("c")
+assert(#calls == 0)
 
 print(string.format("Brush=%s", tostring(t.Brush)))
 print(string.format("Value=%s", tostring(t.Value)))
@@ -110,4 +145,19 @@ info = t.info
 print("info",info)
 
 map1 = t:GetMap()
-print("map1",map1)
\ No newline at end of file
+print("map1",map1)
+
+-- class metatable, object pushed after enabling binds members in metatable of its class
+Test.EnableClassMetatable(true)
+local ct=Test()
+assert(getmetatable(ct)[".get"],"class metatable isn't used")
+-- property by bound getter and setter
+assert(ct.Value==2048)
+ct.Value=100
+assert(ct.Value==100)
+-- UFunction from method table
+assert(ct:ReturnIntWithInt(7)==7)
+-- extension methods aren't bound, they fall back to instance index
+assert(ct:inlineFunc()==1)
+assert(ct:IsA(Test))
+Test.EnableClassMetatable(false)
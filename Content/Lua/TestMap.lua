@@ -43,6 +43,11 @@ local function test()
 		end
 		print("foreach end...")
 
+		local many = map:GetMany({2,8,100})
+		assert(many[2]=="200" and many[8]=="800" and many[100]==nil)
+		local all = map:ToTable()
+		assert(all[5]=="500" and all[9]=="900" and all[1]==nil)
+
 		map:Clear()
 		assert(map:Num()==0)
 	end
@@ -54,6 +59,9 @@ local function test()
 	assert(t.maps:Num()==2)
 	assert(t.maps:Get("name")=="bill")
 	assert(t.maps:Get("age")=="12")
+	-- string key is case insensitive like FString
+	assert(t.maps:Get("NAME")=="bill")
+	assert(t.maps:ToTable()["age"]=="12")
 	mm:Clear()
 	assert(t.maps:Num()==0)
 end
@@ -0,0 +1,49 @@
+-- run by option state, see UMyGameInstance::Init
+
+local Test=import('SluaTestCase')
+-- pool allocator of this state takes blocks freed by gc thread
+slua.threadGC("on")
+local t=Test()
+
+-- object handle, object referenced only by weak ptr of t is deleted by engine gc,
+-- stale handle is detected by serial number when it's used
+local weak=t.weakptr
+assert(slua.isValid(weak))
+local handleFrames=0
+local function testObjectHandle()
+    if slua.isValid(weak) then
+        handleFrames=handleFrames+1
+        assert(handleFrames<600,"weak object isn't deleted by engine gc")
+        return
+    end
+    local ok,err=pcall(function() return weak:GetClass() end)
+    assert(not ok and string.find(err,"freed"),"stale object handle is used")
+    weak=nil
+    print("object handle test ok")
+end
+
+-- garbage of pooled blocks is made, gc cycles must finish and reclaim it
+local gcCycles
+local gcFrames=0
+local baseKB
+local function testPoolGC()
+    local gs=slua.gcStats()
+    if not gcCycles then
+        gcCycles=gs.cycles
+        gcFrames=0
+        baseKB=baseKB or collectgarbage("count")
+        for i=1,10000 do local t={i,tostring(i)} end
+    elseif gs.cycles>gcCycles+1 then
+        -- garbage is swept by the second cycle, blocks are back in the pools
+        assert(collectgarbage("count")<baseKB+1024,"garbage isn't reclaimed with pool allocator")
+        gcCycles=nil
+    else
+        gcFrames=gcFrames+1
+        assert(gcFrames<1200,"gc cycle isn't finished with pool allocator")
+    end
+end
+
+function update(dt)
+    if weak then testObjectHandle() end
+    testPoolGC()
+end
@@ -52,4 +52,14 @@ local start = os.clock()
 for i=1,TestCount do
     t:FuncWithStr("hello world")
 end
-print("1m call FuncWithStr(cppbinding), take time",os.clock()-start)
\ No newline at end of file
+print("1m call FuncWithStr(cppbinding), take time",os.clock()-start)
+-- param marshalling by reflection vs precompiled call plan
+local t=SluaTestCase()
+local reflection,callplan = t:BenchCallPlan("EmptyFunc",TestCount)
+print("1m marshal 0 arg, reflection vs call plan",reflection,callplan)
+reflection,callplan = t:BenchCallPlan("ReturnIntWithInt",TestCount,1)
+print("1m marshal 1 arg, reflection vs call plan",reflection,callplan)
+reflection,callplan = t:BenchCallPlan("FuncWith4Args",TestCount,1,2,3,4)
+print("1m marshal 4 args, reflection vs call plan",reflection,callplan)
+reflection,callplan = t:BenchCallPlan("FuncWith8Args",TestCount,1,2,3,4,5,6,7,8)
+print("1m marshal 8 args, reflection vs call plan",reflection,callplan)
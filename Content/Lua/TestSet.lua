@@ -0,0 +1,35 @@
+local Test=import('SluaTestCase');
+local t=Test();
+
+local function test()
+	local set = slua.Set(EPropertyClass.Int)
+	set:Add(1)
+	set:Add(2)
+	set:Add(2)
+	assert(set:Num()==2)
+	assert(set:Contains(1) and not set:Contains(3))
+	assert(set:Remove(1) and not set:Remove(1))
+	for v in set:Pairs() do
+		assert(v==2)
+	end
+	set:Clear()
+	assert(set:Num()==0)
+
+	local ss = t.sets
+	ss:Add("bill")
+	ss:Add("jamy")
+	assert(t.sets:Num()==2)
+	-- string element is case insensitive like FString
+	assert(t.sets:Contains("BILL"))
+	assert(t.sets:Remove("jamy"))
+	assert(not t.sets:Contains("jamy"))
+	ss:Clear()
+	assert(t.sets:Num()==0)
+end
+
+TestSet={}
+function TestSet.update()
+    test()
+end
+
+return TestSet
@@ -6,6 +6,16 @@ local c = a+b*3.14
 local d = FVector(1,1,1)*3.14*2+FVector(1,1,1)
 assert(c==d)
 
+-- in-place math, no new vector allocated
+local out = FVector()
+FVector.Mul(out,b,3.14)
+out:AddInPlace(a)
+assert(out==c)
+out:Set(1,2,3)
+out:MulInPlace(FVector(2,2,2)):SubInPlace(1)
+local x,y,z = out:Unpack()
+assert(x==1 and y==3 and z==5)
+
 if FLinkStruct then
     st = FLinkStruct()
     b2d = st.b2d
@@ -56,4 +66,19 @@ if FLinkStruct then
         print(2, b2d.Min)
     end)
     print(ret,err)
-end
\ No newline at end of file
+end
+
+-- struct reference, member struct read from object references its memory
+local Test=import('SluaTestCase')
+Test.EnableStructReference(true)
+local owner=Test()
+local info=owner.info
+info.level=99
+assert(owner.info.level==99,"struct member isn't written through reference")
+info.name="ref"
+assert(owner.info.name=="ref")
+-- member is copied on read after disabling
+Test.EnableStructReference(false)
+info=owner.info
+info.level=1
+assert(owner.info.level==99)
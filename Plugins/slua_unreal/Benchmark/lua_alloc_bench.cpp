@@ -0,0 +1,126 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+// compare allocation throughput of default allocator (realloc/free) and LuaPoolAllocator,
+// first on a synthetic trace of lua sized blocks, then on a script creating strings, tables and closures
+// usage: lua_alloc_bench [trace operations] [script iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "lua.hpp"
+#include "LuaPoolAllocator.h"
+
+using namespace NS_SLUA;
+
+static const char* benchScript = R"(
+local n = ...
+local keep = {}
+for i = 1, n do
+    local s = "key" .. i
+    local t = { s, i, x = i * 0.5 }
+    local f = function() return t, s end
+    keep[i % 1000 + 1] = { t = t, f = f }
+end
+return #keep
+)";
+
+static void* defaultAlloc(void*, void* ptr, size_t, size_t nsize) {
+    if (nsize == 0) {
+        free(ptr);
+        return nullptr;
+    }
+    return realloc(ptr, nsize);
+}
+
+// size of lua objects, mostly strings, closures, tables and nodes, few large arrays
+static size_t traceSize(std::mt19937& rng) {
+    int r = rng() % 100;
+    if (r < 90) return 16 + rng() % 112;
+    if (r < 99) return 128 + rng() % 128;
+    return 256 + rng() % 4096;
+}
+
+static double runTrace(lua_Alloc alloc, void* ud, int ops) {
+    std::mt19937 rng(1234);
+    struct Block { void* ptr; size_t size; };
+    std::vector<Block> live(4096, Block{ nullptr, 0 });
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        Block& b = live[rng() % live.size()];
+        if (b.ptr) {
+            // grow some blocks like arrays of table, free others
+            if (rng() % 8 == 0) {
+                size_t nsize = b.size * 2;
+                b.ptr = alloc(ud, b.ptr, b.size, nsize);
+                b.size = nsize;
+            }
+            else {
+                alloc(ud, b.ptr, b.size, 0);
+                b.ptr = nullptr;
+            }
+        }
+        else {
+            b.size = traceSize(rng);
+            b.ptr = alloc(ud, nullptr, LUA_TTABLE, b.size);
+            *(char*)b.ptr = 1;
+        }
+    }
+    for (auto& b : live)
+        if (b.ptr) alloc(ud, b.ptr, b.size, 0);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double runScript(lua_Alloc alloc, void* ud, int iterations) {
+    auto start = std::chrono::steady_clock::now();
+    lua_State* L = lua_newstate(alloc, ud);
+    luaL_openlibs(L);
+    if (luaL_loadstring(L, benchScript) != LUA_OK) {
+        fprintf(stderr, "%s\n", lua_tostring(L, -1));
+        exit(1);
+    }
+    lua_pushinteger(L, iterations);
+    lua_call(L, 1, 0);
+    lua_close(L);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int ops = argc > 1 ? atoi(argv[1]) : 20000000;
+    int iterations = argc > 2 ? atoi(argv[2]) : 2000000;
+    printf("trace operations %d, script iterations %d\n", ops, iterations);
+    printf("%-10s %12s %12s\n", "allocator", "trace(ms)", "script(ms)");
+
+    double trace = runTrace(defaultAlloc, nullptr, ops);
+    double script = runScript(defaultAlloc, nullptr, iterations);
+    printf("%-10s %12.1f %12.1f\n", "default", trace, script);
+
+    LuaPoolAllocator tracePool;
+    trace = runTrace(LuaPoolAllocator::alloc, &tracePool, ops);
+    LuaPoolAllocator scriptPool;
+    script = runScript(LuaPoolAllocator::alloc, &scriptPool, iterations);
+    printf("%-10s %12.1f %12.1f\n", "pool", trace, script);
+
+    const LuaPoolAllocator::Stats& stats = scriptPool.getStats();
+    printf("\npool of script: pages %zu KB, large blocks %llu allocs\n",
+        stats.pageBytes / 1024, (unsigned long long)stats.largeAllocs);
+    printf("%6s %12s %12s %12s\n", "block", "allocs", "peak(KB)", "pages(KB)");
+    for (auto& cs : stats.classes) {
+        if (cs.allocs == 0) continue;
+        printf("%6zu %12llu %12zu %12zu\n", cs.blockSize, (unsigned long long)cs.allocs,
+            cs.peakBytes / 1024, cs.pageBytes / 1024);
+    }
+    return 0;
+}
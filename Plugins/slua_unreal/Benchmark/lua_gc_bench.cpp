@@ -0,0 +1,174 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+// compare pause time and throughput of incremental and generational gc,
+// and of incremental gc whose swept objects are freed by a worker thread,
+// a large long-lived table is built first, then every frame creates short-lived temporaries
+// usage: lua_gc_bench [config entries] [frames] [temporaries per frame]
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lua.hpp"
+
+using namespace NS_SLUA;
+
+static const char* benchScript = R"(
+local n = ...
+config = {}
+for i = 1, n do
+    config[i] = { id = i, name = "item" .. i, values = { i, i + 1, i + 2 } }
+end
+local cache = setmetatable({}, { __mode = "v" })
+function frame(count)
+    local keep = {}
+    for i = 1, count do
+        local t = { x = i, y = i * 2, s = "tmp" .. i }
+        if i % 100 == 0 then
+            keep[#keep + 1] = t
+            -- old objects point to young ones through barriers
+            config[(i * 7) % n + 1].last = t
+            cache[i] = t
+        end
+    end
+    return #keep
+end
+)";
+
+struct Result {
+    double totalMs;
+    double avgMs;
+    double p99Ms;
+    double maxMs;
+    int heapKB;
+};
+
+enum Mode { Incremental, Generational, DeferFree, ModeCount };
+static const char* modeNames[ModeCount] = { "incremental", "generational", "deferfree" };
+
+// frees garbage detached from lua state on its own thread
+class FreeWorker {
+public:
+    FreeWorker(lua_State* L) : stop(false) {
+        alloc = lua_getallocf(L, &ud);
+        thread = std::thread([this] { loop(); });
+    }
+    ~FreeWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_one();
+        thread.join();
+    }
+    void post(void* garbage) {
+        if (!garbage) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(garbage);
+        }
+        cond.notify_one();
+    }
+private:
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cond.wait(lock, [this] { return stop || !queue.empty(); });
+            if (queue.empty()) return;
+            void* garbage = queue.front();
+            queue.pop_front();
+            lock.unlock();
+            lua_freegarbage(alloc, ud, garbage);
+            lock.lock();
+        }
+    }
+    lua_Alloc alloc;
+    void* ud;
+    bool stop;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<void*> queue;
+    std::thread thread;
+};
+
+// allocator of luaL_newstate isn't counted, frees from worker thread are plain free calls
+static void* threadSafeAlloc(void*, void* ptr, size_t, size_t nsize) {
+    if (nsize == 0) {
+        free(ptr);
+        return nullptr;
+    }
+    return realloc(ptr, nsize);
+}
+
+static Result run(Mode mode, int entries, int frames, int count) {
+    lua_State* L = lua_newstate(threadSafeAlloc, nullptr);
+    luaL_openlibs(L);
+    if (luaL_loadstring(L, benchScript) != LUA_OK) {
+        fprintf(stderr, "%s\n", lua_tostring(L, -1));
+        exit(1);
+    }
+    lua_pushinteger(L, entries);
+    lua_call(L, 1, 0);
+    lua_gc(L, mode == Generational ? LUA_GCGEN : LUA_GCINC, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    FreeWorker* worker = nullptr;
+    if (mode == DeferFree) {
+        lua_gc(L, LUA_GCDEFERFREE, 1);
+        worker = new FreeWorker(L);
+    }
+
+    std::vector<double> times;
+    times.reserve(frames);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        auto t = std::chrono::steady_clock::now();
+        lua_getglobal(L, "frame");
+        lua_pushinteger(L, count);
+        lua_call(L, 1, 1);
+        lua_pop(L, 1);
+        if (worker) worker->post(lua_detachgarbage(L));
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count());
+    }
+    Result r;
+    r.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    r.heapKB = lua_gc(L, LUA_GCCOUNT, 0);
+    // pending garbage must be freed before state is closed
+    delete worker;
+    lua_close(L);
+
+    std::sort(times.begin(), times.end());
+    r.avgMs = r.totalMs / frames;
+    r.p99Ms = times[std::min(frames - 1, frames * 99 / 100)];
+    r.maxMs = times.back();
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int entries = argc > 1 ? atoi(argv[1]) : 200000;
+    int frames = argc > 2 ? atoi(argv[2]) : 300;
+    int count = argc > 3 ? atoi(argv[3]) : 20000;
+    printf("config entries %d, frames %d, temporaries per frame %d\n", entries, frames, count);
+    printf("%-14s %10s %10s %10s %10s %10s\n", "mode", "total(ms)", "avg(ms)", "p99(ms)", "max(ms)", "heap(KB)");
+    for (int mode = 0; mode < ModeCount; mode++) {
+        Result r = run((Mode)mode, entries, frames, count);
+        printf("%-14s %10.1f %10.3f %10.3f %10.3f %10d\n", modeNames[mode],
+            r.totalMs, r.avgMs, r.p99Ms, r.maxMs, r.heapKB);
+    }
+    return 0;
+}
@@ -0,0 +1,292 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+// compare construction, copy and push cost of two storages of LuaVar,
+// LuaVar itself needs engine, so its storage is mirrored here on plain lua api:
+// shared - value array on heap, strings copied, references shared by virtual refcounted objects
+// inline - single value inline, strings copied and long ones referenced, copies share a plain refcount
+// usage: lua_var_bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include "lua.hpp"
+
+using namespace NS_SLUA;
+
+enum VarType { VT_NIL, VT_INT, VT_STRING, VT_REF };
+
+struct SharedVar {
+    struct Ref {
+        Ref() :refCount(1) {}
+        virtual ~Ref() {}
+        void addRef() { refCount++; }
+        void release() {
+            if (--refCount == 0) delete this;
+        }
+        int refCount;
+    };
+
+    struct RefStr : public Ref {
+        RefStr(const char* s, size_t len) {
+            buf = (char*)malloc(len + 1);
+            memcpy(buf, s, len);
+            buf[len] = 0;
+            length = len;
+        }
+        virtual ~RefStr() { free(buf); }
+        char* buf;
+        size_t length;
+    };
+
+    struct RefRef : public Ref {
+        RefRef(lua_State* l) :L(l), ref(luaL_ref(l, LUA_REGISTRYINDEX)) {}
+        virtual ~RefRef() { luaL_unref(L, LUA_REGISTRYINDEX, ref); }
+        lua_State* L;
+        int ref;
+    };
+
+    struct Var {
+        union {
+            lua_Integer i;
+            RefStr* s;
+            RefRef* ref;
+        };
+        VarType type;
+    };
+
+    Var* vars;
+    size_t numOfVar;
+
+    SharedVar(lua_State* L, int p) {
+        vars = new Var[1];
+        numOfVar = 1;
+        switch (lua_type(L, p)) {
+        case LUA_TNUMBER:
+            vars[0].i = lua_tointeger(L, p);
+            vars[0].type = VT_INT;
+            break;
+        case LUA_TSTRING: {
+            size_t len;
+            const char* s = lua_tolstring(L, p, &len);
+            vars[0].s = new RefStr(s, len);
+            vars[0].type = VT_STRING;
+            break;
+        }
+        default:
+            lua_pushvalue(L, p);
+            vars[0].ref = new RefRef(L);
+            vars[0].type = VT_REF;
+            break;
+        }
+    }
+
+    SharedVar(const SharedVar& other) {
+        vars = new Var[other.numOfVar];
+        numOfVar = other.numOfVar;
+        for (size_t n = 0; n < numOfVar; n++) {
+            vars[n] = other.vars[n];
+            if (vars[n].type == VT_STRING) vars[n].s->addRef();
+            else if (vars[n].type == VT_REF) vars[n].ref->addRef();
+        }
+    }
+
+    ~SharedVar() {
+        for (size_t n = 0; n < numOfVar; n++) {
+            if (vars[n].type == VT_STRING) vars[n].s->release();
+            else if (vars[n].type == VT_REF) vars[n].ref->release();
+        }
+        delete[] vars;
+    }
+
+    void push(lua_State* L) const {
+        const Var& v = vars[0];
+        if (v.type == VT_INT) lua_pushinteger(L, v.i);
+        else if (v.type == VT_STRING) lua_pushlstring(L, v.s->buf, v.s->length);
+        else lua_geti(L, LUA_REGISTRYINDEX, v.ref->ref);
+    }
+};
+
+struct InlineVar {
+    // non-virtual refcounted block, string chars follow it
+    struct Ref {
+        int refCount;
+        int ref;
+        size_t length;
+        char* buf() { return (char*)(this + 1); }
+    };
+
+    struct Var {
+        union {
+            lua_Integer i;
+            Ref* ref;
+        };
+        VarType type;
+    };
+
+    lua_State* L;
+    Var* vars;
+    size_t numOfVar;
+    Var inlineVar;
+
+    InlineVar(lua_State* l, int p) :L(l), vars(&inlineVar), numOfVar(1) {
+        switch (lua_type(L, p)) {
+        case LUA_TNUMBER:
+            inlineVar.i = lua_tointeger(L, p);
+            inlineVar.type = VT_INT;
+            return;
+        case LUA_TSTRING: {
+            // strings are copied, long ones are referenced too
+            size_t len;
+            const char* s = lua_tolstring(L, p, &len);
+            Ref* r = (Ref*)malloc(sizeof(Ref) + len + 1);
+            memcpy(r->buf(), s, len);
+            r->buf()[len] = 0;
+            r->length = len;
+            r->ref = LUA_NOREF;
+            if (len > 40) {
+                lua_pushvalue(L, p);
+                r->ref = luaL_ref(L, LUA_REGISTRYINDEX);
+            }
+            r->refCount = 1;
+            inlineVar.ref = r;
+            inlineVar.type = VT_STRING;
+            return;
+        }
+        default:
+            inlineVar.ref = (Ref*)malloc(sizeof(Ref));
+            inlineVar.ref->refCount = 1;
+            lua_pushvalue(L, p);
+            inlineVar.ref->ref = luaL_ref(L, LUA_REGISTRYINDEX);
+            inlineVar.type = VT_REF;
+            return;
+        }
+    }
+
+    InlineVar(const InlineVar& other) :L(other.L), vars(&inlineVar), numOfVar(1) {
+        inlineVar = other.inlineVar;
+        if (inlineVar.type != VT_INT) inlineVar.ref->refCount++;
+    }
+
+    ~InlineVar() {
+        for (size_t n = 0; n < numOfVar; n++) {
+            if (vars[n].type == VT_INT || --vars[n].ref->refCount > 0) continue;
+            if (vars[n].ref->ref != LUA_NOREF) luaL_unref(L, LUA_REGISTRYINDEX, vars[n].ref->ref);
+            free(vars[n].ref);
+        }
+        if (vars != &inlineVar) delete[] vars;
+    }
+
+    void push(lua_State* l) const {
+        const Var& v = vars[0];
+        if (v.type == VT_INT) lua_pushinteger(l, v.i);
+        else if (v.type == VT_STRING && v.ref->ref == LUA_NOREF) lua_pushlstring(l, v.ref->buf(), v.ref->length);
+        else lua_geti(l, LUA_REGISTRYINDEX, v.ref->ref);
+    }
+};
+
+// values are placed in slots so construction can't be optimized away
+static const int SlotCount = 256;
+
+typedef std::chrono::steady_clock Clock;
+
+static double nsPerOp(Clock::time_point start, int iterations) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+template<class V>
+struct Slots {
+    alignas(V) unsigned char storage[SlotCount][sizeof(V)];
+    V* at(int i) { return (V*)storage[i]; }
+    void destroy(int n) {
+        for (int i = 0; i < n; i++) at(i)->~V();
+    }
+};
+
+// construct from stack value and destroy
+template<class V>
+double benchConstruct(lua_State* L, int idx, int iterations) {
+    Slots<V>* slots = new Slots<V>();
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i += SlotCount) {
+        for (int k = 0; k < SlotCount; k++) new (slots->at(k)) V(L, idx);
+        slots->destroy(SlotCount);
+    }
+    double ns = nsPerOp(start, iterations);
+    delete slots;
+    return ns;
+}
+
+// copy construct and destroy
+template<class V>
+double benchCopy(lua_State* L, int idx, int iterations) {
+    Slots<V>* slots = new Slots<V>();
+    V src(L, idx);
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i += SlotCount) {
+        for (int k = 0; k < SlotCount; k++) new (slots->at(k)) V(src);
+        slots->destroy(SlotCount);
+    }
+    double ns = nsPerOp(start, iterations);
+    delete slots;
+    return ns;
+}
+
+// push to stack and pop
+template<class V>
+double benchPush(lua_State* L, int idx, int iterations) {
+    V v(L, idx);
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        v.push(L);
+        lua_pop(L, 1);
+    }
+    return nsPerOp(start, iterations);
+}
+
+template<class V>
+void runCase(lua_State* L, const char* storage, const char* name, int idx, int iterations) {
+    double construct = benchConstruct<V>(L, idx, iterations);
+    double copy = benchCopy<V>(L, idx, iterations);
+    double push = benchPush<V>(L, idx, iterations);
+    printf("%-8s %-14s %14.1f %10.1f %10.1f\n", storage, name, construct, copy, push);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000000;
+    iterations = (iterations + SlotCount - 1) / SlotCount * SlotCount;
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    std::string longStr(256, 'x');
+
+    lua_pushinteger(L, 42);
+    lua_pushstring(L, "OnClicked");
+    lua_pushlstring(L, longStr.data(), longStr.size());
+    lua_newtable(L);
+    luaL_loadstring(L, "return 1");
+    const char* names[] = { "int", "short string", "long string", "table", "function" };
+
+    printf("iterations %d, cost per operation in ns\n", iterations);
+    printf("%-8s %-14s %14s %10s %10s\n", "storage", "value", "construct", "copy", "push");
+    for (int i = 0; i < 5; i++) {
+        runCase<SharedVar>(L, "shared", names[i], i + 1, iterations);
+        runCase<InlineVar>(L, "inline", names[i], i + 1, iterations);
+    }
+    lua_close(L);
+    return 0;
+}
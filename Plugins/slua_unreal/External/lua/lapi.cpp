@@ -1078,7 +1078,8 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
         luaC_checkGC(L);
       }
       g->gcrunning = oldrunning;  /* restore previous state */
-      if (debt > 0 && g->gcstate == GCSpause)  /* end of cycle? */
+      /* end of cycle? (a step is a whole collection in generational mode) */
+      if (debt > 0 && (g->gcstate == GCSpause || isgenerational(g)))
         res = 1;  /* signal it */
       break;
     }
@@ -1093,10 +1094,31 @@ LUA_API int lua_gc (lua_State *L, int what, int data) {
       g->gcstepmul = data;
       break;
     }
+    case LUA_GCSETMAJORINC: {
+      res = g->gcmajorinc;
+      g->gcmajorinc = data;
+      break;
+    }
     case LUA_GCISRUNNING: {
       res = g->gcrunning;
       break;
     }
+    case LUA_GCGEN: {  /* change collector to generational mode */
+      res = isgenerational(g) ? LUA_GCGEN : LUA_GCINC;
+      if (data > 0) g->gcminormul = data;
+      luaC_changemode(L, 1);
+      break;
+    }
+    case LUA_GCINC: {  /* change collector to incremental mode */
+      res = isgenerational(g) ? LUA_GCGEN : LUA_GCINC;
+      luaC_changemode(L, 0);
+      break;
+    }
+    case LUA_GCDEFERFREE: {  /* let host free swept objects */
+      res = g->gcdeferfree;
+      g->gcdeferfree = (data != 0);
+      break;
+    }
     default: res = -1;  /* invalid option */
   }
   lua_unlock(L);
@@ -1162,6 +1184,24 @@ LUA_API void lua_len (lua_State *L, int idx) {
 }
 
 
+LUA_API void *lua_detachgarbage (lua_State *L) {
+  GCObject *o;
+  lua_lock(L);
+  o = G(L)->tofree;
+  G(L)->tofree = NULL;
+  lua_unlock(L);
+  return o;
+}
+
+
+/*
+** does not touch any state, so it may be called from other threads
+*/
+LUA_API void lua_freegarbage (lua_Alloc f, void *ud, void *garbage) {
+  luaC_freegarbage(f, ud, cast(GCObject *, garbage));
+}
+
+
 LUA_API lua_Alloc lua_getallocf (lua_State *L, void **ud) {
   lua_Alloc f;
   lua_lock(L);
@@ -194,6 +194,8 @@ void luaC_fix (lua_State *L, GCObject *o) {
   global_State *g = G(L);
   lua_assert(g->allgc == o);  /* object must be 1st in 'allgc' list! */
   white2gray(o);  /* they will be gray forever */
+  if (g->genold == o)  /* keep boundary of old objects in 'allgc' */
+    g->genold = o->next;
   g->allgc = o->next;  /* remove object from 'allgc' list */
   o->next = g->fixedgc;  /* link it to 'fixedgc' list */
   g->fixedgc = o;
@@ -375,7 +377,7 @@ static void traverseweakvalue (global_State *g, Table *h) {
   }
   if (g->gcstate == GCSpropagate)
     linkgclist(h, g->grayagain);  /* must retraverse it in atomic phase */
-  else if (hasclears)
+  else if (hasclears || isgenerational(g))  /* generational mode keeps all */
     linkgclist(h, g->weak);  /* has to be cleared later */
 }
 
@@ -423,7 +425,7 @@ static int traverseephemeron (global_State *g, Table *h) {
     linkgclist(h, g->grayagain);  /* must retraverse it in atomic phase */
   else if (hasww)  /* table has white->white entries? */
     linkgclist(h, g->ephemeron);  /* have to propagate again */
-  else if (hasclears)  /* table has white keys? */
+  else if (hasclears || isgenerational(g))  /* table has white keys? */
     linkgclist(h, g->allweak);  /* may have to clean white keys */
   return marked;
 }
@@ -692,7 +694,105 @@ static void freeLclosure (lua_State *L, LClosure *cl) {
 }
 
 
+/*
+** memory held by an object whose release is deferred
+*/
+static lu_mem deferredsize (GCObject *o) {
+  switch (o->tt) {
+    case LUA_TPROTO: {
+      Proto *f = gco2p(o);
+      return sizeof(Proto) + sizeof(Instruction) * f->sizecode +
+                             sizeof(Proto *) * f->sizep +
+                             sizeof(TValue) * f->sizek +
+                             sizeof(int) * f->sizelineinfo +
+                             sizeof(LocVar) * f->sizelocvars +
+                             sizeof(Upvaldesc) * f->sizeupvalues;
+    }
+    case LUA_TLCL: return sizeLclosure(gco2lcl(o)->nupvalues);
+    case LUA_TCCL: return sizeCclosure(gco2ccl(o)->nupvalues);
+    case LUA_TTABLE: {
+      Table *h = gco2t(o);
+      return sizeof(Table) + sizeof(Node) * allocsizenode(h) +
+                             sizeof(TValue) * h->sizearray;
+    }
+    case LUA_TUSERDATA: return sizeudata(gco2u(o));
+    case LUA_TSHRSTR: return sizelstring(gco2ts(o)->shrlen);
+    case LUA_TLNGSTR: return sizelstring(gco2ts(o)->u.lnglen);
+    default: lua_assert(0); return 0;
+  }
+}
+
+
+/*
+** unlink-only part of 'freeobj': do what needs the state, then chain
+** the object in 'tofree' and account its memory as already released
+*/
+static void deferobj (lua_State *L, GCObject *o) {
+  global_State *g = G(L);
+  switch (o->tt) {
+    case LUA_TLCL: {
+      LClosure *cl = gco2lcl(o);
+      int i;
+      for (i = 0; i < cl->nupvalues; i++) {
+        UpVal *uv = cl->upvals[i];
+        if (uv)
+          luaC_upvdeccount(L, uv);
+      }
+      break;
+    }
+    case LUA_TSHRSTR:
+      luaS_remove(L, gco2ts(o));  /* remove it from hash table */
+      break;
+    default: break;
+  }
+  g->GCdebt -= deferredsize(o);
+  o->next = g->tofree;
+  g->tofree = o;
+}
+
+
+#define freeblock(f,ud,b,n)	((void)(*f)(ud, (b), (n)*sizeof(*(b)), 0))
+
+/*
+** free objects chained by 'deferobj'; uses only the allocator
+*/
+void luaC_freegarbage (lua_Alloc f, void *ud, GCObject *o) {
+  while (o != NULL) {
+    GCObject *next = o->next;
+    switch (o->tt) {
+      case LUA_TPROTO: {
+        Proto *p = gco2p(o);
+        freeblock(f, ud, p->code, p->sizecode);
+        freeblock(f, ud, p->p, p->sizep);
+        freeblock(f, ud, p->k, p->sizek);
+        freeblock(f, ud, p->lineinfo, p->sizelineinfo);
+        freeblock(f, ud, p->locvars, p->sizelocvars);
+        freeblock(f, ud, p->upvalues, p->sizeupvalues);
+        freeblock(f, ud, p, 1);
+        break;
+      }
+      case LUA_TTABLE: {
+        Table *h = gco2t(o);
+        if (!isdummy(h))
+          freeblock(f, ud, h->node, cast(size_t, sizenode(h)));
+        freeblock(f, ud, h->array, h->sizearray);
+        freeblock(f, ud, h, 1);
+        break;
+      }
+      default:
+        (*f)(ud, o, deferredsize(o), 0);
+        break;
+    }
+    o = next;
+  }
+}
+
+
 static void freeobj (lua_State *L, GCObject *o) {
+  if (G(L)->gcdeferfree && o->tt != LUA_TTHREAD) {
+    deferobj(L, o);
+    return;
+  }
   switch (o->tt) {
     case LUA_TPROTO: luaF_freeproto(L, gco2p(o)); break;
     case LUA_TLCL: {
@@ -790,8 +890,8 @@ static GCObject *udata2finalize (global_State *g) {
   o->next = g->allgc;  /* return it to 'allgc' list */
   g->allgc = o;
   resetbit(o->marked, FINALIZEDBIT);  /* object is "normal" again */
-  if (issweepphase(g))
-    makewhite(g, o);  /* "sweep" object */
+  if (issweepphase(g) || isgenerational(g))
+    makewhite(g, o);  /* "sweep" object (or make it young again) */
   return o;
 }
 
@@ -909,6 +1009,8 @@ void luaC_checkfinalizer (lua_State *L, GCObject *o, Table *mt) {
       if (g->sweepgc == &o->next)  /* should not remove 'sweepgc' object */
         g->sweepgc = sweeptolive(L, g->sweepgc);  /* change 'sweepgc' */
     }
+    if (g->genold == o)  /* keep boundary of old objects in 'allgc' */
+      g->genold = o->next;
     /* search for pointer pointing to 'o' */
     for (p = &g->allgc; *p != o; p = &(*p)->next) { /* empty */ }
     *p = o->next;  /* remove 'o' from 'allgc' list */
@@ -964,6 +1066,9 @@ static void entersweep (lua_State *L) {
 
 void luaC_freeallobjects (lua_State *L) {
   global_State *g = G(L);
+  g->gcdeferfree = 0;  /* free everything now */
+  luaC_freegarbage(g->frealloc, g->ud, g->tofree);
+  g->tofree = NULL;
   separatetobefnz(g, 1);  /* separate all objects with finalizers */
   lua_assert(g->finobj == NULL);
   callallpendingfinalizers(L);
@@ -982,6 +1087,7 @@ static l_mem atomic (lua_State *L) {
   l_mem work;
   GCObject *origweak, *origall;
   GCObject *grayagain = g->grayagain;  /* save original list */
+  g->grayagain = NULL;  /* threads traversed below are linked in a new list */
   lua_assert(g->ephemeron == NULL && g->weak == NULL);
   lua_assert(!iswhite(g->mainthread));
   g->gcstate = GCSinsideatomic;
@@ -1106,6 +1212,151 @@ void luaC_runtilstate (lua_State *L, int statesmask) {
 }
 
 
+/*
+** {======================================================
+** Generational Collector
+** =======================================================
+*/
+
+
+/*
+** free dead young objects, which are in front of 'genold' in 'allgc'
+** list; survivors keep their marks and so become old. (Objects in
+** 'finobj' are not swept: dead ones were moved to 'tobefnz' by the
+** atomic phase, all others are marked.)
+*/
+static void sweepyoung (lua_State *L, global_State *g) {
+  int ow = otherwhite(g);
+  GCObject **p = &g->allgc;
+  GCObject *curr;
+  while ((curr = *p) != g->genold) {
+    if (isdeadm(ow, curr->marked)) {  /* is 'curr' dead? */
+      *p = curr->next;  /* remove 'curr' from list */
+      freeobj(L, curr);  /* erase 'curr' */
+    }
+    else
+      p = &curr->next;  /* keep mark, object is old now */
+  }
+  g->genold = g->allgc;  /* all survivors are old */
+}
+
+
+/*
+** weak tables are always gray; they must be traversed and cleared again
+** by next collection, as young objects may be stored into them without
+** barriers. Move them from the weak lists to 'grayagain', where
+** threads left by 'atomic' already are.
+*/
+static void keepweaktables (global_State *g) {
+  GCObject **lists[] = { &g->weak, &g->allweak, &g->ephemeron };
+  int i;
+  for (i = 0; i < 3; i++) {
+    GCObject *next = *lists[i];
+    while (next != NULL) {
+      Table *h = gco2t(next);
+      next = h->gclist;
+      linkgclist(h, g->grayagain);
+    }
+    *lists[i] = NULL;
+  }
+}
+
+
+/*
+** minor collection: mark objects reachable from gray lists (filled by
+** barriers, threads and weak tables), finish with the atomic phase and
+** sweep young objects. Collector goes back to propagate phase without
+** restarting, so old objects keep marked.
+*/
+static void youngcollection (lua_State *L, global_State *g) {
+  lua_assert(g->gcstate == GCSpropagate);
+  propagateall(g);
+  atomic(L);
+  g->gcstate = GCSswpallgc;
+  sweepyoung(L, g);
+  keepweaktables(g);
+  g->gcstate = GCSpropagate;  /* skip restart */
+  checkSizes(L, g);
+}
+
+
+/*
+** major collection: sweep all objects to turn them back to white (as
+** white has not changed, nothing is collected), restart the collection
+** and do a minor collection over the whole 'allgc' list.
+*/
+static void fullgen (lua_State *L, global_State *g) {
+  lua_assert(g->gcstate == GCSpropagate);
+  entersweep(L);
+  luaC_runtilstate(L, bitmask(GCSpause));
+  restartcollection(g);
+  g->gcstate = GCSpropagate;
+  g->genold = NULL;  /* all objects are young */
+  youngcollection(L, g);
+  g->GCestimate = gettotalbytes(g);  /* base of next major collection */
+}
+
+
+/*
+** next minor collection starts after allocating 'gcminormul'% of memory
+** in use
+*/
+static void setminordebt (global_State *g) {
+  l_mem debt = cast(l_mem, gettotalbytes(g) / 100) * g->gcminormul;
+  luaE_setdebt(g, -debt);
+}
+
+
+static void genstep (lua_State *L, global_State *g) {
+  if (g->GCestimate == 0)  /* signal for a major collection? */
+    fullgen(L, g);
+  else {
+    lu_mem estimate = g->GCestimate;
+    youngcollection(L, g);
+    /* memory grew too much since last major collection? */
+    if (gettotalbytes(g) > (estimate / 100) * g->gcmajorinc)
+      g->GCestimate = 0;  /* signal for a major collection */
+    else
+      g->GCestimate = estimate;  /* keep estimate from last major coll. */
+  }
+  setminordebt(g);
+  while (g->tobefnz)
+    GCTM(L, 1);  /* call all finalizers, collection is not incremental */
+}
+
+
+/*
+** change collector to generational ('gen' true) or incremental mode.
+** Entering generational mode finishes current cycle and does a full
+** collection making all live objects old. Leaving it sweeps all objects
+** to turn them back to white.
+*/
+void luaC_changemode (lua_State *L, int gen) {
+  global_State *g = G(L);
+  if (!gen == !isgenerational(g)) return;  /* nothing to change */
+  if (gen) {
+    luaC_runtilstate(L, bitmask(GCSpause));  /* finish current cycle */
+    g->gcgen = 1;
+    restartcollection(g);
+    g->gcstate = GCSpropagate;
+    g->genold = NULL;  /* all objects are young */
+    youngcollection(L, g);
+    g->GCestimate = gettotalbytes(g);
+    setminordebt(g);
+  }
+  else {
+    g->gcgen = 0;
+    g->genold = NULL;
+    entersweep(L);
+    luaC_runtilstate(L, bitmask(GCSpause));
+    g->GCestimate = gettotalbytes(g);
+    setpause(g);
+  }
+}
+
+/* }====================================================== */
+
+
 /*
 ** get GC debt and convert it from Kb to 'work units' (avoid zero debt
 ** and overflows)
@@ -1131,6 +1382,10 @@ void luaC_step (lua_State *L) {
     luaE_setdebt(g, -GCSTEPSIZE * 10);  /* avoid being called too often */
     return;
   }
+  if (isgenerational(g)) {  /* a step is a whole minor collection */
+    genstep(L, g);
+    return;
+  }
   do {  /* repeat until pause or enough "credit" (negative debt) */
     lu_mem work = singlestep(L);  /* perform one single step */
     debt -= work;
@@ -1158,6 +1413,19 @@ void luaC_fullgc (lua_State *L, int isemergency) {
   global_State *g = G(L);
   lua_assert(g->gckind == KGC_NORMAL);
   if (isemergency) g->gckind = KGC_EMERGENCY;  /* set flag */
+  if (isgenerational(g)) {
+    /* not in propagate phase only if called by a finalizer run by a
+       major collection, which cannot be restarted */
+    if (g->gcstate == GCSpropagate)
+      fullgen(L, g);
+    g->gckind = KGC_NORMAL;
+    setminordebt(g);
+    if (!isemergency) {
+      while (g->tobefnz)
+        GCTM(L, 1);
+    }
+    return;
+  }
   if (keepinvariant(g)) {  /* black objects? */
     entersweep(L); /* sweep everything to turn them back to white */
   }
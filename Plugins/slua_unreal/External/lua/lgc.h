@@ -61,6 +61,28 @@
 #define keepinvariant(g)	((g)->gcstate <= GCSatomic)
 
 
+/*
+** In generational mode, the collector stays in the propagate phase
+** between collections, so the invariant is always kept. Objects which
+** survived a collection keep their marks ("old"); a minor collection
+** marks from gray lists filled by barriers and sweeps only the objects
+** created after the last collection ("young"), which are in front of
+** 'genold' in the 'allgc' list.
+*/
+#define isgenerational(g)	((g)->gcgen)
+
+
+/*
+** With 'gcdeferfree' set, the sweep phase only unlinks dead objects
+** (and does what must be done on the owner thread: removing strings
+** from the string table, releasing upvalues, freeing threads) and
+** chains them in 'tofree'. Their memory is subtracted from the debt at
+** once; the host detaches the chain and releases it with
+** 'luaC_freegarbage', which touches nothing but the allocator, so it
+** may run on another thread while the state keeps running.
+*/
+
+
 /*
 ** some useful bit tricks
 */
@@ -138,6 +160,8 @@ LUAI_FUNC void luaC_freeallobjects (lua_State *L);
 LUAI_FUNC void luaC_step (lua_State *L);
 LUAI_FUNC void luaC_runtilstate (lua_State *L, int statesmask);
 LUAI_FUNC void luaC_fullgc (lua_State *L, int isemergency);
+LUAI_FUNC void luaC_changemode (lua_State *L, int gen);
+LUAI_FUNC void luaC_freegarbage (lua_Alloc f, void *ud, GCObject *o);
 LUAI_FUNC GCObject *luaC_newobj (lua_State *L, int tt, size_t sz);
 LUAI_FUNC void luaC_barrier_ (lua_State *L, GCObject *o, GCObject *v);
 LUAI_FUNC void luaC_barrierback_ (lua_State *L, Table *o);
@@ -33,6 +33,14 @@
 #define LUAI_GCMUL	200 /* GC runs 'twice the speed' of memory allocation */
 #endif
 
+#if !defined(LUAI_GCMAJOR)
+#define LUAI_GCMAJOR	200  /* 200%: major collection when memory doubles */
+#endif
+
+#if !defined(LUAI_GCMINORMUL)
+#define LUAI_GCMINORMUL	50  /* minor collection after allocating 50% of live heap */
+#endif
+
 
 /*
 ** a macro to help the creation of a unique random seed when a state is
@@ -320,7 +328,11 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->version = NULL;
   g->gcstate = GCSpause;
   g->gckind = KGC_NORMAL;
+  g->gcgen = 0;
+  g->gcdeferfree = 0;
   g->allgc = g->finobj = g->tobefnz = g->fixedgc = NULL;
+  g->genold = NULL;
+  g->tofree = NULL;
   g->sweepgc = NULL;
   g->gray = g->grayagain = NULL;
   g->weak = g->ephemeron = g->allweak = NULL;
@@ -330,6 +342,8 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->gcfinnum = 0;
   g->gcpause = LUAI_GCPAUSE;
   g->gcstepmul = LUAI_GCMUL;
+  g->gcmajorinc = LUAI_GCMAJOR;
+  g->gcminormul = LUAI_GCMINORMUL;
   for (i=0; i < LUA_NUMTAGS; i++) g->mt[i] = NULL;
   if (luaD_rawrunprotected(L, f_luaopen, NULL) != LUA_OK) {
     /* memory allocation error: free partial state */
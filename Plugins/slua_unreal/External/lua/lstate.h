@@ -126,6 +126,8 @@ typedef struct global_State {
   lu_byte currentwhite;
   lu_byte gcstate;  /* state of garbage collector */
   lu_byte gckind;  /* kind of GC running */
+  lu_byte gcgen;  /* true if collector is in generational mode */
+  lu_byte gcdeferfree;  /* true if dead objects are freed by the host */
   lu_byte gcrunning;  /* true if GC is running */
   GCObject *allgc;  /* list of all collectable objects */
   GCObject **sweepgc;  /* current position of sweep in list */
@@ -137,10 +139,14 @@ typedef struct global_State {
   GCObject *allweak;  /* list of all-weak tables */
   GCObject *tobefnz;  /* list of userdata to be GC */
   GCObject *fixedgc;  /* list of objects not to be collected */
+  GCObject *genold;  /* first old object in 'allgc' (generational mode) */
+  GCObject *tofree;  /* list of swept objects waiting to be freed */
   struct lua_State *twups;  /* list of threads with open upvalues */
   unsigned int gcfinnum;  /* number of finalizers to call in each GC step */
   int gcpause;  /* size of pause between successive GCs */
   int gcstepmul;  /* GC 'granularity' */
+  int gcmajorinc;  /* growth since last major collection to start a new one */
+  int gcminormul;  /* allocation, in percent of memory in use, to do a minor one */
   lua_CFunction panic;  /* to be called in unprotected errors */
   struct lua_State *mainthread;
   const lua_Number *version;  /* pointer to version number */
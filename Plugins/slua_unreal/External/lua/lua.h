@@ -308,10 +308,18 @@ LUA_API int (lua_isyieldable) (lua_State *L);
 #define LUA_GCSTEP		5
 #define LUA_GCSETPAUSE		6
 #define LUA_GCSETSTEPMUL	7
+#define LUA_GCSETMAJORINC	8
 #define LUA_GCISRUNNING		9
+#define LUA_GCGEN		10
+#define LUA_GCINC		11
+#define LUA_GCDEFERFREE		12
 
 LUA_API int (lua_gc) (lua_State *L, int what, int data);
 
+/* dead objects swept with LUA_GCDEFERFREE, freed on any thread */
+LUA_API void *(lua_detachgarbage) (lua_State *L);
+LUA_API void  (lua_freegarbage) (lua_Alloc f, void *ud, void *garbage);
+
 
 /*
 ** miscellaneous functions
@@ -257,6 +257,10 @@
 #if defined(_WIN32)
 #undef LUA_API
 #define LUA_API extern "C" __declspec(dllexport)
+#elif defined(__GNUC__)
+/* lua is compiled into slua_unreal, other modules call api of its shared library */
+#undef LUA_API
+#define LUA_API extern __attribute__((visibility("default")))
 #endif
 
 /* more often than not the libs go together with the core */
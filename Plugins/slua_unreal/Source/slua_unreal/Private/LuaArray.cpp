@@ -21,6 +21,7 @@
 namespace NS_SLUA {
 
     DefTypeName(LuaArray::Enumerator); 
+    DefTypeName(LuaArray::BufferView);
 
     void LuaArray::reg(lua_State* L) {
         SluaUtil::reg(L,"Array",__ctor);
@@ -340,6 +341,261 @@ namespace NS_SLUA {
 		return 0;
 	}
 
+	LuaArray::PODKind LuaArray::getPODKind(UProperty* p) {
+		auto cls = p->GetClass();
+		if (cls == UIntProperty::StaticClass()) return PODKind::Int;
+		if (cls == UFloatProperty::StaticClass()) return PODKind::Float;
+		if (cls == UDoubleProperty::StaticClass()) return PODKind::Double;
+		if (cls == UBoolProperty::StaticClass()) return PODKind::Bool;
+		if (cls == UByteProperty::StaticClass()) return PODKind::Byte;
+		return PODKind::None;
+	}
+
+	// ToTable([first,count]), first is 0-based index of array, result table is 1-based
+	// תΪlua table
+	int LuaArray::ToTable(lua_State* L) {
+		CheckUD(LuaArray, L, 1);
+		int n = UD->num();
+		int first = LuaObject::checkValueOpt<int>(L, 2, 0);
+		int count = LuaObject::checkValueOpt<int>(L, 3, n - first);
+		if (first < 0 || count < 0 || first + count > n)
+			luaL_error(L, "Array ToTable range(%d,%d) out of range", first, count);
+
+		UProperty* element = UD->inner;
+		uint8* ptr = UD->getRawPtr(first);
+		lua_createtable(L, count, 0);
+		switch (getPODKind(element)) {
+		case PODKind::Int:
+			for (int i = 0; i < count; i++) {
+				lua_pushinteger(L, reinterpret_cast<int32*>(ptr)[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		case PODKind::Float:
+			for (int i = 0; i < count; i++) {
+				lua_pushnumber(L, reinterpret_cast<float*>(ptr)[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		case PODKind::Double:
+			for (int i = 0; i < count; i++) {
+				lua_pushnumber(L, reinterpret_cast<double*>(ptr)[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		case PODKind::Bool: {
+			auto bp = Cast<UBoolProperty>(element);
+			for (int i = 0; i < count; i++, ptr += element->ElementSize) {
+				lua_pushboolean(L, bp->GetPropertyValue(ptr));
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		}
+		case PODKind::Byte:
+			for (int i = 0; i < count; i++) {
+				lua_pushinteger(L, ptr[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		default: {
+			auto pusher = LuaObject::getPusher(element);
+			if (!pusher) {
+				FString tn = element->GetClass()->GetName();
+				luaL_error(L, "unsupport param type %s to push", TCHAR_TO_UTF8(*tn));
+			}
+			for (int i = 0; i < count; i++, ptr += element->ElementSize) {
+				if (!pusher(L, element, ptr, true))
+					lua_pushnil(L);
+				lua_rawseti(L, -2, i + 1);
+			}
+			break;
+		}
+		}
+		return 1;
+	}
+
+	void LuaArray::appendTable(lua_State* L, int t) {
+		luaL_checktype(L, t, LUA_TTABLE);
+		int count = (int)lua_rawlen(L, t);
+		if (count == 0) return;
+
+		// add all items at once, construct them before fill
+		int first = array->Add(count, inner->ElementSize);
+		constructItems(first, count);
+		uint8* ptr = getRawPtr(first);
+
+		// added items are removed if luaL_error is raised by a wrong value, array is unchanged then
+		// Ԫʹʱع
+		struct AppendGuard {
+			LuaArray* arr;
+			int first;
+			int count;
+			bool done;
+			~AppendGuard() {
+				if (done) return;
+				arr->destructItems(first, count);
+				arr->array->Remove(first, count, arr->inner->ElementSize);
+			}
+		} guard = { this, first, count, false };
+
+		switch (getPODKind(inner)) {
+		case PODKind::Int:
+		case PODKind::Byte: {
+			bool isByte = inner->ElementSize == 1;
+			for (int i = 0; i < count; i++) {
+				int isnum;
+				lua_rawgeti(L, t, i + 1);
+				lua_Integer v = lua_tointegerx(L, -1, &isnum);
+				if (!isnum) luaL_error(L, "Array expect integer at table index %d", i + 1);
+				if (isByte) ptr[i] = (uint8)v;
+				else reinterpret_cast<int32*>(ptr)[i] = (int32)v;
+				lua_pop(L, 1);
+			}
+			break;
+		}
+		case PODKind::Float:
+		case PODKind::Double: {
+			bool isFloat = inner->ElementSize == sizeof(float);
+			for (int i = 0; i < count; i++) {
+				int isnum;
+				lua_rawgeti(L, t, i + 1);
+				lua_Number v = lua_tonumberx(L, -1, &isnum);
+				if (!isnum) luaL_error(L, "Array expect number at table index %d", i + 1);
+				if (isFloat) reinterpret_cast<float*>(ptr)[i] = (float)v;
+				else reinterpret_cast<double*>(ptr)[i] = v;
+				lua_pop(L, 1);
+			}
+			break;
+		}
+		case PODKind::Bool: {
+			auto bp = Cast<UBoolProperty>(inner);
+			for (int i = 0; i < count; i++, ptr += inner->ElementSize) {
+				lua_rawgeti(L, t, i + 1);
+				bp->SetPropertyValue(ptr, !!lua_toboolean(L, -1));
+				lua_pop(L, 1);
+			}
+			break;
+		}
+		default: {
+			auto checker = LuaObject::getChecker(inner);
+			if (!checker) {
+				FString tn = inner->GetClass()->GetName();
+				luaL_error(L, "unsupport param type %s to add", TCHAR_TO_UTF8(*tn));
+			}
+			for (int i = 0; i < count; i++, ptr += inner->ElementSize) {
+				lua_rawgeti(L, t, i + 1);
+				checker(L, inner, ptr, lua_gettop(L));
+				lua_pop(L, 1);
+			}
+			break;
+		}
+		}
+		guard.done = true;
+	}
+
+	// FromTable(t), replace all items by sequence of t
+	int LuaArray::FromTable(lua_State* L) {
+		CheckUD(LuaArray, L, 1);
+		luaL_checktype(L, 2, LUA_TTABLE);
+		// old items are removed after new items are filled, array is unchanged on error
+		int old = UD->num();
+		UD->appendTable(L, 2);
+		UD->destructItems(0, old);
+		UD->array->Remove(0, old, UD->inner->ElementSize);
+		return LuaObject::push(L, UD->num());
+	}
+
+	// Append(t), add items of t to the end
+	int LuaArray::Append(lua_State* L) {
+		CheckUD(LuaArray, L, 1);
+		UD->appendTable(L, 2);
+		return LuaObject::push(L, UD->num());
+	}
+
+	// View(), return typed view over memory of array, only array of int/float/double/bool/byte supported
+	int LuaArray::View(lua_State* L) {
+		CheckUD(LuaArray, L, 1);
+		PODKind kind = getPODKind(UD->inner);
+		if (kind == PODKind::None) {
+			FString tn = UD->inner->GetClass()->GetName();
+			luaL_error(L, "unsupport type %s to view", TCHAR_TO_UTF8(*tn));
+		}
+		auto view = new LuaArray::BufferView();
+		// hold LuaArray
+		view->holder = new LuaVar(L, 1);
+		view->arr = UD;
+		view->kind = kind;
+		return LuaObject::pushType(L, view, "LuaArray::BufferView", BufferView::setupMT, BufferView::gc);
+	}
+
+	int LuaArray::BufferView::__index(lua_State* L) {
+		CheckSelf(LuaArray::BufferView);
+		int isnum;
+		lua_Integer i = lua_tointegerx(L, 2, &isnum);
+		if (!isnum) luaL_error(L, "Array view index should be integer");
+		auto arr = self->arr;
+		// check range before narrowing, large index shouldn't wrap to a valid one
+		if (i < 0 || i >= arr->num())
+			luaL_error(L, "Array view index %I out of range", i);
+
+		uint8* ptr = arr->getRawPtr((int)i);
+		switch (self->kind) {
+		case PODKind::Int: lua_pushinteger(L, *reinterpret_cast<int32*>(ptr)); break;
+		case PODKind::Float: lua_pushnumber(L, *reinterpret_cast<float*>(ptr)); break;
+		case PODKind::Double: lua_pushnumber(L, *reinterpret_cast<double*>(ptr)); break;
+		case PODKind::Bool: lua_pushboolean(L, Cast<UBoolProperty>(arr->inner)->GetPropertyValue(ptr)); break;
+		case PODKind::Byte: lua_pushinteger(L, *ptr); break;
+		default: lua_pushnil(L); break;
+		}
+		return 1;
+	}
+
+	int LuaArray::BufferView::__newindex(lua_State* L) {
+		CheckSelf(LuaArray::BufferView);
+		int isnum;
+		lua_Integer i = lua_tointegerx(L, 2, &isnum);
+		if (!isnum) luaL_error(L, "Array view index should be integer");
+		auto arr = self->arr;
+		// check range before narrowing, large index shouldn't wrap to a valid one
+		if (i < 0 || i >= arr->num())
+			luaL_error(L, "Array view index %I out of range", i);
+
+		uint8* ptr = arr->getRawPtr((int)i);
+		switch (self->kind) {
+		case PODKind::Int: *reinterpret_cast<int32*>(ptr) = (int32)luaL_checkinteger(L, 3); break;
+		case PODKind::Float: *reinterpret_cast<float*>(ptr) = (float)luaL_checknumber(L, 3); break;
+		case PODKind::Double: *reinterpret_cast<double*>(ptr) = luaL_checknumber(L, 3); break;
+		case PODKind::Bool: Cast<UBoolProperty>(arr->inner)->SetPropertyValue(ptr, !!lua_toboolean(L, 3)); break;
+		case PODKind::Byte: *ptr = (uint8)luaL_checkinteger(L, 3); break;
+		default: break;
+		}
+		return 0;
+	}
+
+	int LuaArray::BufferView::__len(lua_State* L) {
+		CheckSelf(LuaArray::BufferView);
+		lua_pushinteger(L, self->arr->num());
+		return 1;
+	}
+
+	int LuaArray::BufferView::setupMT(lua_State* L) {
+		RegMetaMethodByName(L, "__index", __index);
+		RegMetaMethodByName(L, "__newindex", __newindex);
+		RegMetaMethodByName(L, "__len", __len);
+		return 0;
+	}
+
+	int LuaArray::BufferView::gc(lua_State* L) {
+		CheckUD(LuaArray::BufferView, L, 1);
+		delete UD;
+		return 0;
+	}
+
+	LuaArray::BufferView::~BufferView()
+	{
+		SafeDelete(holder);
+	}
+
 	// Ԫ
     int LuaArray::setupMT(lua_State* L) {
         LuaObject::setupMTSelfSearch(L);
@@ -352,6 +608,10 @@ namespace NS_SLUA {
         RegMetaMethod(L,Insert);
         RegMetaMethod(L,Remove);
         RegMetaMethod(L,Clear);
+		RegMetaMethod(L,ToTable);
+		RegMetaMethod(L,FromTable);
+		RegMetaMethod(L,Append);
+		RegMetaMethod(L,View);
 
 		RegMetaMethodByName(L, "__pairs", Pairs);
 
@@ -23,10 +23,47 @@ extern uint8 GRegisterNative(int32 NativeBytecodeIndex, const FNativeFuncPtr& Fu
 ULuaTableObjectInterface::ULuaTableObjectInterface(const class FObjectInitializer& OI)
 	:Super(OI) {}
 
+DECLARE_STATS_GROUP(TEXT("Slua"), STATGROUP_Slua, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ProcessEvent Intercepted"), STAT_SluaProcessEventIntercepted, STATGROUP_Slua);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ProcessEvent Passed Through"), STAT_SluaProcessEventPassed, STATGROUP_Slua);
+
 namespace NS_SLUA {
 
+	LuaBase* checkBase(UObject* obj);
+
+	// bit of each UFunction overridden by any lua instance, indexed by object index of UFunction,
+	// bits marked through slots of unloaded class are cleared when its slots are dropped
+	// luaصUFunctionλͼ,
+	static TArray<uint32> overriddenFuncBits;
+
+	static void setOverriddenBit(int32 index) {
+		int32 word = index >> 5;
+		if (word >= overriddenFuncBits.Num())
+			overriddenFuncBits.AddZeroed(word + 1 - overriddenFuncBits.Num());
+		overriddenFuncBits[word] |= 1u << (index & 31);
+	}
+
+	// index is recorded in marked set of slots, UFunction may be gone when slots are dropped
+	static void markOverridden(UFunction* func, TSet<int32>& marked) {
+		int32 index = func->GetUniqueID();
+		marked.Add(index);
+		setOverriddenBit(index);
+	}
+
+	static bool isOverridden(UFunction* func) {
+		int32 index = func->GetUniqueID();
+		int32 word = index >> 5;
+		return word < overriddenFuncBits.Num() && (overriddenFuncBits[word] & (1u << (index & 31)));
+	}
+
 	bool LuaBase::luaImplemented(UFunction * func, void * params)
 	{
+		// most ProcessEvent calls are engine events not overridden by lua
+		if (!isOverridden(func)) {
+			INC_DWORD_STAT(STAT_SluaProcessEventPassed);
+			return false;
+		}
+
 		if (indexFlag!=IF_NONE && func==currentFunction) return false;
 
 		// Ƿͼ
@@ -36,11 +73,15 @@ namespace NS_SLUA {
 		if (!luaSelfTable.isTable())
 			return false;
 
-		NS_SLUA::LuaVar lfunc = luaSelfTable.getFromTable<NS_SLUA::LuaVar>((const char*)TCHAR_TO_UTF8(*func->GetName()), true);
-		if (!lfunc.isValid()) return false;
+		NS_SLUA::LuaVar* lfunc = getOverrideFunc(func);
+		if (!lfunc || !lfunc->isValid()) {
+			INC_DWORD_STAT(STAT_SluaProcessEventPassed);
+			return false;
+		}
 
+		INC_DWORD_STAT(STAT_SluaProcessEventIntercepted);
 		// һʵ,Աself
-		return lfunc.callByUFunction(func, (uint8*)params, &luaSelfTable);
+		return lfunc->callByUFunction(func, (uint8*)params, &luaSelfTable);
 	}
 
 	// Called every frame
@@ -52,7 +93,7 @@ namespace NS_SLUA {
 			superTick();
 			return;
 		}
-		tickFunction.call(luaSelfTable, DeltaTime);
+		tickFunction.callTyped<void>(luaSelfTable, DeltaTime);
 	}
 
 	void LuaBase::superTick(lua_State* L)
@@ -66,15 +107,16 @@ namespace NS_SLUA {
 		UObject* obj = context.Get();
 		if (!obj) return 0;
 
-		FStructOnScope params(func);
+		auto plan = LuaObject::getCallPlan(L, func);
+		FuncParamsScope params(func, plan->needInit, plan->needDestroy);
 		// 
-		LuaObject::fillParam(L, 2, func, params.GetStructMemory());
+		LuaObject::fillParam(L, 2, plan, params.get());
 		{
 			// call function with params
-			LuaObject::callUFunction(L, obj, func, params.GetStructMemory());
+			LuaObject::callUFunction(L, obj, func, params.get());
 		}
 		// return value to push lua stack
-		return LuaObject::returnValue(L, func, params.GetStructMemory());
+		return LuaObject::returnValue(L, plan, params.get());
 	}
 
 	int LuaBase::__index(NS_SLUA::lua_State * L)
@@ -120,6 +162,12 @@ namespace NS_SLUA {
 			lua_pushvalue(L, 3);
 			// rawset to table
 			lua_rawset(L, 1);
+
+			// replace cached override function
+			if (lua_type(L, 2) == LUA_TSTRING) {
+				LuaBase* lb = checkBase(LuaObject::checkValue<UObject*>(L, 4));
+				if (lb) lb->updateOverrideFunc(lua_tostring(L, 2), L, 3);
+			}
 		}
 		return 0;
 	}
@@ -188,9 +236,11 @@ namespace NS_SLUA {
 		void* params = Stack.Locals;
 
 		LuaVar& luaSelfTable = lb->luaSelfTable;
-		NS_SLUA::LuaVar lfunc = luaSelfTable.getFromTable<NS_SLUA::LuaVar>(func->GetName(), true);
-		if (lfunc.isValid()) {
-			lfunc.callByUFunction(func, (uint8*)params, &luaSelfTable, Stack.OutParms);
+		// slot isn't copied, callByUFunction pushes function before calling and doesn't read slot after,
+		// so field could be reassigned in call
+		NS_SLUA::LuaVar* lfunc = lb->getOverrideFunc(func);
+		if (lfunc && lfunc->isValid()) {
+			lfunc->callByUFunction(func, (uint8*)params, &luaSelfTable, Stack.OutParms);
 			*(bool*)RESULT_PARAM = true;
 		}
 		else {
@@ -209,13 +259,152 @@ namespace NS_SLUA {
 		UClass* cls = obj->GetClass();
 		ensure(cls);
 
-		// ͼ
-		EFunctionFlags availableFlag = FUNC_BlueprintEvent;
-		for (TFieldIterator<UFunction> it(cls); it; ++it) {
-			if (!(it->FunctionFlags&availableFlag))
+		// resolve lua function of each blueprint event once, hook overridden ones
+		// ÿͼֻѯһlua
+		overrideSlots = getOverrideSlots(cls);
+		bindOverrideNames();
+		overrideFuncs.Empty();
+		overrideFuncs.SetNum(overrideSlots->nameSlots.Num());
+		// field set to other value may be assigned a function later without __newindex, hook it too
+		TArray<bool> fieldSet;
+		fieldSet.SetNumZeroed(overrideSlots->nameSlots.Num());
+		for (auto& it : overrideSlots->nameSlots) {
+			LuaVar lfunc = luaSelfTable.getFromTable<LuaVar>(it.Key, true);
+			fieldSet[it.Value] = !lfunc.isNil();
+			if (lfunc.isFunction())
+				overrideFuncs[it.Value] = MoveTemp(lfunc);
+		}
+		for (auto& it : overrideSlots->funcSlots) {
+			if (fieldSet[it.Value]) {
+				hookBpScript(it.Key, (FNativeFuncPtr)&luaOverrideFunc);
+				markOverridden(it.Key, overrideSlots->markedFuncs);
+			}
+		}
+	}
+
+	// key of registry table holding slot name tables by id of OverrideSlots
+	static int overrideNamesKey = 0;
+
+	void LuaBase::bindOverrideNames()
+	{
+		auto L = luaSelfTable.getState();
+		AutoStack as(L);
+		if (lua_rawgetp(L, LUA_REGISTRYINDEX, &overrideNamesKey) != LUA_TTABLE) {
+			lua_pop(L, 1);
+			lua_newtable(L);
+			lua_pushvalue(L, -1);
+			lua_rawsetp(L, LUA_REGISTRYINDEX, &overrideNamesKey);
+		}
+		// names of a class are created once per state and anchored, so they are never collected
+		if (lua_rawgeti(L, -1, overrideSlots->id) != LUA_TTABLE) {
+			lua_pop(L, 1);
+			auto& names = overrideSlots->slotNames;
+			lua_createtable(L, names.Num(), 0);
+			for (int32 i = 0; i < names.Num(); i++) {
+				lua_pushstring(L, names[i].GetData());
+				lua_rawseti(L, -2, i + 1);
+			}
+			lua_pushvalue(L, -1);
+			lua_rawseti(L, -3, overrideSlots->id);
+		}
+		overrideNames = LuaVar(L, -1);
+	}
+
+	TSharedPtr<LuaBase::OverrideSlots> LuaBase::getOverrideSlots(UClass* cls)
+	{
+		static int32 nextSlotsId = 0;
+		static TMap<TWeakObjectPtr<UClass>, TSharedPtr<OverrideSlots>> classSlots;
+		if (auto slots = classSlots.Find(cls))
+			return *slots;
+
+		// drop slots of unloaded class and clear its bits,
+		// inherited function may be marked through other class too, so bits of remaining slots are set again
+		bool dropped = false;
+		for (auto it = classSlots.CreateIterator(); it; ++it) {
+			if (!it.Key().IsValid()) {
+				for (int32 index : it.Value()->markedFuncs) {
+					int32 word = index >> 5;
+					if (word < overriddenFuncBits.Num())
+						overriddenFuncBits[word] &= ~(1u << (index & 31));
+				}
+				it.RemoveCurrent();
+				dropped = true;
+			}
+		}
+		if (dropped) {
+			for (auto& it : classSlots)
+				for (int32 index : it.Value->markedFuncs)
+					setOverriddenBit(index);
+		}
+
+		TSharedPtr<OverrideSlots> slots = MakeShareable(new OverrideSlots());
+		slots->id = ++nextSlotsId;
+		// events of implemented interface could be overridden too
+		for (TFieldIterator<UFunction> it(cls, EFieldIteratorFlags::IncludeSuper, EFieldIteratorFlags::IncludeDeprecated, EFieldIteratorFlags::IncludeInterfaces); it; ++it) {
+			if (!(it->FunctionFlags&FUNC_BlueprintEvent))
 				continue;
-			if (luaSelfTable.getFromTable<LuaVar>(it->GetName(), true).isFunction()) {
-				hookBpScript(*it, (FNativeFuncPtr)&luaOverrideFunc);
+			FString name = it->GetName();
+			int32* slot = slots->nameSlots.Find(name);
+			int32 index = slot ? *slot : slots->nameSlots.Num();
+			if (!slot) {
+				slots->nameSlots.Add(name, index);
+				FTCHARToUTF8 utf8(*name);
+				slots->slotNames.Add(TArray<ANSICHAR>(utf8.Get(), utf8.Length() + 1));
+			}
+			slots->funcSlots.Add(*it, index);
+		}
+		classSlots.Add(cls, slots);
+		return slots;
+	}
+
+	LuaVar* LuaBase::getOverrideFunc(UFunction* func)
+	{
+		const int32* slot = overrideSlots.IsValid() ? overrideSlots->funcSlots.Find(func) : nullptr;
+		if (slot) {
+			LuaVar& lfunc = overrideFuncs[*slot];
+			// existing field is reassigned by raw set without __newindex, refresh cache if it's changed
+			// ֶαֱӸֵʱˢ»
+			auto L = luaSelfTable.getState();
+			if (!L) return &lfunc;
+			AutoStack as(L);
+			luaSelfTable.push(L);
+			overrideNames.push(L);
+			lua_rawgeti(L, -1, *slot + 1);
+			lua_rawget(L, -3);
+			bool changed;
+			if (lfunc.isValid()) {
+				lfunc.push(L);
+				changed = !lua_rawequal(L, -1, -2);
+				lua_pop(L, 1);
+			}
+			else
+				changed = lua_isfunction(L, -1);
+			if (changed)
+				lfunc = lua_isfunction(L, -1) ? LuaVar(L, -1) : LuaVar();
+			return &lfunc;
+		}
+		// slots hold every blueprint event of class, its supers and interfaces,
+		// so hooked or marked function of this object is always found above
+		return nullptr;
+	}
+
+	void LuaBase::updateOverrideFunc(const char* name, lua_State* L, int p)
+	{
+		if (!overrideSlots.IsValid())
+			return;
+		const int32* slot = overrideSlots->nameSlots.Find(UTF8_TO_TCHAR(name));
+		if (!slot)
+			return;
+		if (!lua_isfunction(L, p)) {
+			overrideFuncs[*slot] = LuaVar();
+			return;
+		}
+		overrideFuncs[*slot] = LuaVar(L, p);
+		// event may not be hooked if no instance overrode it before
+		for (auto& it : overrideSlots->funcSlots) {
+			if (it.Value == *slot) {
+				hookBpScript(it.Key, (FNativeFuncPtr)&luaOverrideFunc);
+				markOverridden(it.Key, overrideSlots->markedFuncs);
 			}
 		}
 	}
@@ -368,6 +557,5 @@ int ILuaTableObjectInterface::push(NS_SLUA::lua_State * L, ILuaTableObjectInterf
 		NS_SLUA::Log::Error("Can't get a valid lua self table, push nil instead.");
 		return NS_SLUA::LuaObject::pushNil(L);
 	}
-	auto self = luaTableObj->getSelfTable();
-	return self.push(L);
+	return luaTableObj->getSelfTable().push(L);
 }
@@ -127,7 +127,7 @@ FLuaBPVar ULuaBlueprintLibrary::CreateVarFromObject(UObject* WorldContextObject,
 	// objջ
     lua_pop(ls->getLuaState(),1);
 	// LuaVarFLuaBPVar
-    return FLuaBPVar(ret);
+    return FLuaBPVar(MoveTemp(ret));
 }
 
 int FLuaBPVar::checkValue(NS_SLUA::lua_State* L, UStructProperty* p, uint8* params, int i)
@@ -13,17 +13,22 @@
 
 #include "LuaObject.h"
 #include "LuaVar.h"
+#include "LuaState.h"
 #include "LuaDelegate.h"
 
 ULuaDelegate::ULuaDelegate(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
     ,luafunction(nullptr)
     ,ufunction(nullptr)
+    ,dispatchState(-1)
+    ,dispatchDepth(0)
 {
 }
 
 ULuaDelegate::~ULuaDelegate() {
     SafeDelete(luafunction);
+    for (auto& listener : listeners)
+        SafeDelete(listener.func);
 }
 
 void ULuaDelegate::EventTrigger()
@@ -32,10 +37,76 @@ void ULuaDelegate::EventTrigger()
 }
 
 void ULuaDelegate::ProcessEvent( UFunction* f, void* Parms ) {
+    if (dispatchState >= 0) {
+        dispatch(reinterpret_cast<uint8*>(Parms));
+        return;
+    }
     ensure(luafunction!=nullptr && ufunction!=nullptr);
     luafunction->callByUFunction(ufunction,reinterpret_cast<uint8*>(Parms));
 }
 
+void ULuaDelegate::dispatch(uint8* parms) {
+    using namespace NS_SLUA;
+    // listener may dispose delegate in call
+    UFunction* func = ufunction;
+    auto ls = LuaState::get(dispatchState);
+    if (!ls || !func) return;
+    lua_State* L = ls->getLuaState();
+    AutoStack as(L);
+
+    // push parameters once, each listener is called with copies of them
+    // ֻѹջһ
+    int argBase = lua_gettop(L) + 1;
+    int argn = NS_SLUA::LuaVar::pushParms(L, func, parms);
+
+    // listener added in broadcast is called from next broadcast
+    int32 count = listeners.Num();
+    dispatchDepth++;
+    for (int32 i = 0; i < count; i++) {
+        NS_SLUA::LuaVar* luafunc = listeners[i].func;
+        // removed in broadcast
+        if (!luafunc) continue;
+        for (int n = 0; n < argn; n++)
+            lua_pushvalue(L, argBase + n);
+        luafunc->callWithParms(func, parms, argn);
+    }
+    dispatchDepth--;
+    if (dispatchDepth == 0)
+        listeners.RemoveAll([](const NS_SLUA::LuaDelegateListener& listener) { return listener.func == nullptr; });
+}
+
+void* ULuaDelegate::addListener(NS_SLUA::lua_State* L, int p, UFunction* ufunc) {
+    luaL_checktype(L,p,LUA_TFUNCTION);
+    ensure(ufunc);
+    ufunction = ufunc;
+    dispatchState = NS_SLUA::LuaState::get(L)->stateIndex();
+    // handle is only compared, never dereferenced
+    static UPTRINT handleCounter = 0;
+    void* handle = reinterpret_cast<void*>(++handleCounter);
+    listeners.Add({ new NS_SLUA::LuaVar(L,p,NS_SLUA::LuaVar::LV_FUNCTION), handle });
+    return handle;
+}
+
+bool ULuaDelegate::removeListener(void* handle) {
+    for (int32 i = 0; i < listeners.Num(); i++) {
+        auto& listener = listeners[i];
+        if (listener.handle != handle || !listener.func)
+            continue;
+        SafeDelete(listener.func);
+        // keep indices of broadcast in progress
+        if (dispatchDepth == 0)
+            listeners.RemoveAt(i);
+        return true;
+    }
+    return false;
+}
+
+bool ULuaDelegate::hasListener() const {
+    for (auto& listener : listeners)
+        if (listener.func) return true;
+    return false;
+}
+
 void ULuaDelegate::bindFunction(NS_SLUA::lua_State* L,int p,UFunction* ufunc) {
     luaL_checktype(L,p,LUA_TFUNCTION);
     ensure(ufunc);
@@ -58,6 +129,10 @@ void ULuaDelegate::bindFunction(UFunction *ufunc) {
 void ULuaDelegate::dispose()
 {
 	SafeDelete(luafunction);
+	for (auto& listener : listeners)
+		SafeDelete(listener.func);
+	if (dispatchDepth == 0)
+		listeners.Empty();
 	ufunction = nullptr;
 }
 namespace NS_SLUA {
@@ -82,38 +157,53 @@ namespace NS_SLUA {
 
 	DefTypeName(LuaDelegateWrap);
 
+    // dispatcher of lua listeners bound to delegate
+    static ULuaDelegate* findDispatcher(lua_State* L, FMulticastScriptDelegate* delegate) {
+        int stateIndex = LuaState::get(L)->stateIndex();
+        for (auto it : delegate->GetAllObjects()) {
+            ULuaDelegate* delegateObj = Cast<ULuaDelegate>(it);
+            if (delegateObj && delegateObj->isDispatcherOf(stateIndex))
+                return delegateObj;
+        }
+        return nullptr;
+    }
+
     int LuaMultiDelegate::Add(lua_State* L) {
         CheckUD(LuaMultiDelegateWrap,L,1);
 
-        // bind luafucntion and signature function
-        auto obj = NewObject<ULuaDelegate>((UObject*)GetTransientPackage(),ULuaDelegate::StaticClass());
+        ULuaDelegate* obj = findDispatcher(L, UD->delegate);
+        if (!obj) {
+            obj = NewObject<ULuaDelegate>((UObject*)GetTransientPackage(),ULuaDelegate::StaticClass());
 #if WITH_EDITOR
-		obj->setPropName(UD->pName);
+            obj->setPropName(UD->pName);
 #endif
-        obj->bindFunction(L,2,UD->ufunc);
-
-        // add event listener
-    	// ¼ί
-        FScriptDelegate Delegate;
-        Delegate.BindUFunction(obj, TEXT("EventTrigger"));
-        UD->delegate->AddUnique(Delegate);
+            // add event listener
+            // ¼ί
+            FScriptDelegate Delegate;
+            Delegate.BindUFunction(obj, TEXT("EventTrigger"));
+            UD->delegate->AddUnique(Delegate);
+
+            // add reference
+            // ӵ
+            LuaObject::addRef(L,obj,nullptr,true);
+        }
 
-        // add reference
-    	// ӵ
-        LuaObject::addRef(L,obj,nullptr,true);
+        // bind luafucntion and signature function
+        void* handle = obj->addListener(L,2,UD->ufunc);
 
     	// û
-        lua_pushlightuserdata(L,obj);
+        lua_pushlightuserdata(L,handle);
         return 1;
     }
 
     int LuaMultiDelegate::Remove(lua_State* L) {
         CheckUD(LuaMultiDelegateWrap,L,1);
         if(!lua_islightuserdata(L,2))
-            luaL_error(L,"arg 2 expect ULuaDelegate");
-        auto obj =  reinterpret_cast<ULuaDelegate*>(lua_touserdata(L,2));
+            luaL_error(L,"arg 2 expect handle returned by Add");
+        void* handle = lua_touserdata(L,2);
+        ULuaDelegate* obj = findDispatcher(L, UD->delegate);
     	// жЧ
-		if (!obj->IsValidLowLevel())
+		if (!obj || !obj->removeListener(handle))
 		{
 #if UE_BUILD_DEVELOPMENT
 			luaL_error(L, "Invalid ULuaDelegate!");
@@ -122,6 +212,10 @@ namespace NS_SLUA {
 #endif
 		}
 
+        // unbind dispatcher after its last listener is removed
+        if (obj->hasListener())
+            return 0;
+
     	// ί,Ƴ
         FScriptDelegate Delegate;
         Delegate.BindUFunction(obj, TEXT("EventTrigger"));
@@ -0,0 +1,194 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaGCScheduler.h"
+#include "lua/lstate.h"
+#include "lua/lgc.h"
+
+namespace NS_SLUA {
+
+	namespace {
+		const int32 MinStepKB = 1;
+		const int32 MaxStepKB = 1024;
+		const int32 DefaultStepKB = 128;
+		// default pause and stepmul of lua
+		const int32 DefaultPause = 200;
+		const int32 DefaultStepMul = 200;
+		// start next cycle at once and collect faster when heap is above target
+		const int32 AggressivePause = 100;
+		const int32 AggressiveStepMul = 400;
+
+		TMap<FString, LuaGCScheduler::Config>& stateConfigs() {
+			static TMap<FString, LuaGCScheduler::Config> configs;
+			return configs;
+		}
+	}
+
+	LuaGCScheduler::LuaGCScheduler()
+	{
+		reset();
+	}
+
+	void LuaGCScheduler::setStateConfig(const FString& stateName, const Config& config)
+	{
+		stateConfigs().Add(stateName, config);
+	}
+
+	LuaGCScheduler::Config LuaGCScheduler::getStateConfig(const FString& stateName)
+	{
+		auto config = stateConfigs().Find(stateName);
+		return config ? *config : Config();
+	}
+
+	void LuaGCScheduler::setConfig(const Config& c)
+	{
+		config = c;
+	}
+
+	void LuaGCScheduler::reset()
+	{
+		stats = Stats();
+		stats.stepKB = DefaultStepKB;
+		stats.pause = DefaultPause;
+		stats.stepmul = DefaultStepMul;
+		avgFrameTime = 0;
+		lastHeapKB = 0;
+		level = 0;
+	}
+
+	void LuaGCScheduler::adjustParams(lua_State* L, int32 heapKB)
+	{
+		if (config.targetHeapKB <= 0)
+			return;
+		// hysteresis, back to default only if heap is well below target
+		int32 newLevel = level;
+		if (heapKB > config.targetHeapKB)
+			newLevel = 1;
+		else if (heapKB < config.targetHeapKB / 2)
+			newLevel = 0;
+		if (newLevel == level)
+			return;
+		level = newLevel;
+		stats.pause = level ? AggressivePause : DefaultPause;
+		stats.stepmul = level ? AggressiveStepMul : DefaultStepMul;
+		lua_gc(L, LUA_GCSETPAUSE, stats.pause);
+		lua_gc(L, LUA_GCSETSTEPMUL, stats.stepmul);
+	}
+
+	void LuaGCScheduler::tick(lua_State* L, float dtime)
+	{
+		stats.frames++;
+		// smoothed frame time, frame shorter than it has slack
+		avgFrameTime = avgFrameTime > 0 ? avgFrameTime * 0.9 + dtime * 0.1 : dtime;
+
+		int32 heapKB = lua_gc(L, LUA_GCCOUNT, 0);
+		int32 growth = heapKB - lastHeapKB;
+		lastHeapKB = heapKB;
+		stats.heapKB = heapKB;
+		adjustParams(L, heapKB);
+
+		bool overTarget = config.targetHeapKB > 0 && heapKB > config.targetHeapKB;
+		if (growth <= 0 && !overTarget && stats.debtMs <= 0) {
+			stats.idleFrames++;
+			// a started cycle still needs a minimum step, or it never finishes once heap stops growing
+			if (G(L)->gcstate != GCSpause) {
+				double start = FPlatformTime::Seconds();
+				stepOnce(L);
+				stats.lastFrameMs = (FPlatformTime::Seconds() - start) * 1000.0;
+			}
+			else
+				stats.lastFrameMs = 0;
+			return;
+		}
+
+		// don't make a hitch longer, unless heap is far above target
+		bool mustCollect = config.targetHeapKB > 0 && heapKB > config.targetHeapKB * 2;
+		if (dtime > avgFrameTime * config.hitchRatio && !mustCollect) {
+			stats.deferredFrames++;
+			// cap debt to avoid a long catch up
+			stats.debtMs = FMath::Min<double>(stats.debtMs + config.budgetMs, config.budgetMs * 4);
+			stats.lastFrameMs = 0;
+			return;
+		}
+
+		double budgetMs = config.budgetMs;
+		if (stats.debtMs > 0 && dtime <= avgFrameTime) {
+			double extra = FMath::Min<double>(stats.debtMs, config.budgetMs);
+			budgetMs += extra;
+			stats.debtMs -= extra;
+		}
+		step(L, budgetMs);
+	}
+
+	bool LuaGCScheduler::stepOnce(lua_State* L, double* cost)
+	{
+		double t = FPlatformTime::Seconds();
+		// return 1 if a cycle is finished
+		int finished = lua_gc(L, LUA_GCSTEP, stats.stepKB);
+		double costMs = (FPlatformTime::Seconds() - t) * 1000.0;
+		if (cost) *cost = costMs / 1000.0;
+		stats.steps++;
+		stats.maxStepMs = FMath::Max(stats.maxStepMs, costMs);
+		// keep a single step well inside budget, atomic phase may still exceed it
+		if (costMs > config.budgetMs * 0.5 && stats.stepKB > MinStepKB)
+			stats.stepKB = FMath::Max(stats.stepKB / 2, MinStepKB);
+		else if (costMs < config.budgetMs * 0.125 && stats.stepKB < MaxStepKB)
+			stats.stepKB = FMath::Min(stats.stepKB * 2, MaxStepKB);
+		if (finished)
+			stats.cycles++;
+		return finished != 0;
+	}
+
+	void LuaGCScheduler::step(lua_State* L, double budgetMs)
+	{
+		double start = FPlatformTime::Seconds();
+		double end = start + budgetMs / 1000.0;
+		double cost = 0;
+		do {
+			if (stepOnce(L, &cost))
+				break;
+		// don't start a step which is expected to exceed budget
+		} while (FPlatformTime::Seconds() + cost < end);
+		stats.lastFrameMs = (FPlatformTime::Seconds() - start) * 1000.0;
+	}
+
+	int LuaGCScheduler::push(lua_State* L) const
+	{
+		lua_newtable(L);
+		lua_pushinteger(L, (lua_Integer)stats.frames);
+		lua_setfield(L, -2, "frames");
+		lua_pushinteger(L, (lua_Integer)stats.steps);
+		lua_setfield(L, -2, "steps");
+		lua_pushinteger(L, (lua_Integer)stats.cycles);
+		lua_setfield(L, -2, "cycles");
+		lua_pushinteger(L, (lua_Integer)stats.idleFrames);
+		lua_setfield(L, -2, "idleFrames");
+		lua_pushinteger(L, (lua_Integer)stats.deferredFrames);
+		lua_setfield(L, -2, "deferredFrames");
+		lua_pushnumber(L, stats.lastFrameMs);
+		lua_setfield(L, -2, "lastFrameMs");
+		lua_pushnumber(L, stats.maxStepMs);
+		lua_setfield(L, -2, "maxStepMs");
+		lua_pushnumber(L, stats.debtMs);
+		lua_setfield(L, -2, "debtMs");
+		lua_pushinteger(L, stats.stepKB);
+		lua_setfield(L, -2, "stepKB");
+		lua_pushinteger(L, stats.heapKB);
+		lua_setfield(L, -2, "heapKB");
+		lua_pushinteger(L, stats.pause);
+		lua_setfield(L, -2, "pause");
+		lua_pushinteger(L, stats.stepmul);
+		lua_setfield(L, -2, "stepmul");
+		return 1;
+	}
+}
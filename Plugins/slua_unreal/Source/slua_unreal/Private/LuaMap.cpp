@@ -73,7 +73,8 @@ namespace NS_SLUA {
 		valueProp(vp) ,
 		prop(nullptr),
 		propObj(nullptr),
-		helper(FScriptMapHelper::CreateHelperFormInnerProperties(keyProp, valueProp, map)) 
+		helper(FScriptMapHelper::CreateHelperFormInnerProperties(keyProp, valueProp, map)),
+		keyKind(getKeyKind(kp))
 	{
 		if (buf) {
 			clone(map,kp,vp,buf);
@@ -93,7 +94,8 @@ namespace NS_SLUA {
 		propObj(obj),
 		helper(prop, map),
 		createdByBp(false),
-		shouldFree(false)
+		shouldFree(false),
+		keyKind(getKeyKind(p->KeyProp))
 	{
 	} 
 
@@ -212,21 +214,72 @@ namespace NS_SLUA {
 		}
 	}
 
-	// modified FScriptMapHelper::RemovePair function to call LuaMap::RemoveAt
-	bool LuaMap::removePair(const void* KeyPtr) {
-		UProperty* LocalKeyPropForCapture = keyProp;
-		if (uint8* Entry = map->FindValue(KeyPtr, helper.MapLayout,
-			[LocalKeyPropForCapture](const void* ElementKey) { return LocalKeyPropForCapture->GetValueTypeHash(ElementKey); },
-			[LocalKeyPropForCapture](const void* A, const void* B) { return LocalKeyPropForCapture->Identical(A, B); }
-		)) {
-			int32 Idx = (Entry - (uint8*)map->GetData(0, helper.MapLayout)) / helper.MapLayout.SetLayout.Size;
-			removeAt(Idx);
-			return true;
-		} else {
-			return false;
+	LuaMap::KeyKind LuaMap::getKeyKind(UProperty* p) {
+		auto cls = p->GetClass();
+		if (cls == UIntProperty::StaticClass()) return KeyKind::Int;
+		if (cls == UInt64Property::StaticClass()) return KeyKind::Int64;
+		if (cls == UNameProperty::StaticClass()) return KeyKind::Name;
+		if (cls == UStrProperty::StaticClass()) return KeyKind::Str;
+		if (cls == UObjectProperty::StaticClass()) return KeyKind::Object;
+		return KeyKind::None;
+	}
+
+	// hash and compare key as T directly, same as GetValueTypeHash/Identical of key property
+	template<typename T>
+	uint8* LuaMap::findValueByKey(const T& key) {
+		uint32 hash = GetTypeHash(key);
+		return map->FindValue(&key, helper.MapLayout,
+			[hash](const void*) { return hash; },
+			[](const void* A, const void* B) { return *(const T*)A == *(const T*)B; }
+		);
+	}
+
+	uint8* LuaMap::findValue(lua_State* L, int p) {
+		switch (keyKind) {
+		case KeyKind::Int:
+			return findValueByKey(LuaObject::checkValue<int>(L, p));
+		case KeyKind::Int64:
+			return findValueByKey(LuaObject::checkValue<int64>(L, p));
+		case KeyKind::Object:
+			return findValueByKey(LuaObject::checkValue<UObject*>(L, p));
+		case KeyKind::Name: {
+			// only find in name table, if name not existed, key not existed too
+			const char* s = luaL_checkstring(L, p);
+			FName name(UTF8_TO_TCHAR(s), FNAME_Find);
+			if (name.IsNone() && *s && FCStringAnsi::Stricmp(s, "None") != 0)
+				return nullptr;
+			return findValueByKey(name);
+		}
+		case KeyKind::Str: {
+			// convert to TCHAR on stack buffer, no FString allocated
+			// FString hash and compare are case insensitive
+			FUTF8ToTCHAR str(luaL_checkstring(L, p));
+			const TCHAR* key = str.Get();
+			uint32 hash = FCrc::Strihash_DEPRECATED(key);
+			return map->FindValue(key, helper.MapLayout,
+				[hash](const void*) { return hash; },
+				[](const void* A, const void* B) { return FCString::Stricmp((const TCHAR*)A, **(const FString*)B) == 0; }
+			);
+		}
+		default: {
+			auto keyChecker = LuaObject::getChecker(keyProp);
+			if (!keyChecker) {
+				auto tn = keyProp->GetClass()->GetName();
+				luaL_error(L, "unsupport key type %s to get", TCHAR_TO_UTF8(*tn));
+			}
+			FDefaultConstructedPropertyElement tempKey(keyProp);
+			auto keyPtr = tempKey.GetObjAddress();
+			keyChecker(L, keyProp, (uint8*)keyPtr, p);
+			return helper.FindValueFromHash(keyPtr);
+		}
 		}
 	}
 
+	void LuaMap::removeValue(uint8* valuePtr) {
+		int32 Idx = (valuePtr - (uint8*)map->GetData(0, helper.MapLayout)) / helper.MapLayout.SetLayout.Size;
+		removeAt(Idx);
+	}
+
 	// modified FScriptMapHelper::RemoveAt function to call LuaMap::DestructItems
 	void LuaMap::removeAt(int32 Index, int32 Count) {
 		check(helper.IsValidIndex(Index));
@@ -265,12 +318,7 @@ namespace NS_SLUA {
 
 	int LuaMap::Get(lua_State* L) {
 		CheckUD(LuaMap, L, 1);
-		GET_CHECKER(key);
-		FDefaultConstructedPropertyElement tempKey(UD->keyProp);
-		auto keyPtr = tempKey.GetObjAddress();
-		keyChecker(L, UD->keyProp, (uint8*)keyPtr, 2);
-
-		auto valuePtr = UD->helper.FindValueFromHash(keyPtr);
+		auto valuePtr = UD->findValue(L, 2);
 		if (valuePtr) {
 			LuaObject::push(L, UD->valueProp, valuePtr);
 			LuaObject::push(L, true);
@@ -285,6 +333,13 @@ namespace NS_SLUA {
 		CheckUD(LuaMap, L, 1);
 		GET_CHECKER(key);
 		GET_CHECKER(value);
+		// value of existing key is updated in place, no temporary key and value constructed
+		if (UD->keyKind != KeyKind::None) {
+			if (auto existing = UD->findValue(L, 2)) {
+				valueChecker(L, UD->valueProp, existing, 3);
+				return 0;
+			}
+		}
 		FDefaultConstructedPropertyElement tempKey(UD->keyProp);
 		FDefaultConstructedPropertyElement tempValue(UD->valueProp);
 		auto keyPtr = tempKey.GetObjAddress();
@@ -297,11 +352,9 @@ namespace NS_SLUA {
 
 	int LuaMap::Remove(lua_State* L) {
 		CheckUD(LuaMap, L, 1);
-		GET_CHECKER(key);
-		FDefaultConstructedPropertyElement tempKey(UD->keyProp);
-		auto keyPtr = tempKey.GetObjAddress();
-		keyChecker(L, UD->keyProp, (uint8*)keyPtr, 2);
-		return LuaObject::push(L, UD->removePair(keyPtr));
+		auto valuePtr = UD->findValue(L, 2);
+		if (valuePtr) UD->removeValue(valuePtr);
+		return LuaObject::push(L, valuePtr != nullptr);
 	}
 
 	int LuaMap::Clear(lua_State* L) {
@@ -310,6 +363,42 @@ namespace NS_SLUA {
 		return 0;
 	}
 
+	// GetMany(keys), return table of key-value for keys found in map
+	int LuaMap::GetMany(lua_State* L) {
+		CheckUD(LuaMap, L, 1);
+		luaL_checktype(L, 2, LUA_TTABLE);
+		int count = (int)lua_rawlen(L, 2);
+		lua_createtable(L, 0, count);
+		for (int i = 1; i <= count; i++) {
+			lua_rawgeti(L, 2, i);
+			auto valuePtr = UD->findValue(L, -1);
+			if (valuePtr) {
+				LuaObject::push(L, UD->valueProp, valuePtr);
+				lua_rawset(L, -3);
+			}
+			else
+				lua_pop(L, 1);
+		}
+		return 1;
+	}
+
+	// ToTable(), copy all pairs into a new lua table
+	int LuaMap::ToTable(lua_State* L) {
+		CheckUD(LuaMap, L, 1);
+		auto& helper = UD->helper;
+		int32 count = UD->num();
+		lua_createtable(L, 0, count);
+		for (int32 index = 0; count > 0; index++) {
+			if (!helper.IsValidIndex(index)) continue;
+			auto pairPtr = helper.GetPairPtr(index);
+			LuaObject::push(L, UD->keyProp, UD->getKeyPtr(pairPtr));
+			LuaObject::push(L, UD->valueProp, UD->getValuePtr(pairPtr));
+			lua_rawset(L, -3);
+			count--;
+		}
+		return 1;
+	}
+
 	int LuaMap::Pairs(lua_State* L) {
 		CheckUD(LuaMap, L, 1);
 		auto iter = new LuaMap::Enumerator();
@@ -372,6 +461,8 @@ namespace NS_SLUA {
 		RegMetaMethod(L, Add);
 		RegMetaMethod(L, Remove);
 		RegMetaMethod(L, Clear);
+		RegMetaMethod(L, GetMany);
+		RegMetaMethod(L, ToTable);
 
 		RegMetaMethodByName(L, "__pairs", Pairs);
 
@@ -0,0 +1,132 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include "LuaObject.h"
+
+namespace NS_SLUA {
+
+	// float components of math struct, accessed by index
+	template<class T>
+	struct MathComponents;
+
+	template<>
+	struct MathComponents<FVector> {
+		enum { Num = 3 };
+		static const char* name() { return "FVector"; }
+		static float& get(FVector& v, int i) { return v[i]; }
+	};
+
+	template<>
+	struct MathComponents<FVector2D> {
+		enum { Num = 2 };
+		static const char* name() { return "FVector2D"; }
+		static float& get(FVector2D& v, int i) { return v[i]; }
+	};
+
+	template<>
+	struct MathComponents<FRotator> {
+		enum { Num = 3 };
+		static const char* name() { return "FRotator"; }
+		static float& get(FRotator& v, int i) { return i == 0 ? v.Pitch : (i == 1 ? v.Yaw : v.Roll); }
+	};
+
+	template<>
+	struct MathComponents<FLinearColor> {
+		enum { Num = 4 };
+		static const char* name() { return "FLinearColor"; }
+		static float& get(FLinearColor& v, int i) { return v.Component(i); }
+	};
+
+	// in-place api of math struct, result is written to self or out param instead of a new userdata,
+	// so hot loop can reuse preallocated values without garbage
+	// v:Set(x,y,z), v:Unpack(), v:AddInPlace(o), FVector.Add(out,a,b), operand o/b can be struct or number
+	// 数学结构体的原地操作,结果写入self或out参数,不产生新的userdata
+	template<class T>
+	struct MathInPlaceWrapper {
+		typedef MathComponents<T> Components;
+
+		struct Add { static float apply(float a, float b) { return a + b; } };
+		struct Sub { static float apply(float a, float b) { return a - b; } };
+		struct Mul { static float apply(float a, float b) { return a * b; } };
+		struct Div { static float apply(float a, float b) { return a / b; } };
+
+		static T* checkStruct(lua_State* L, int i) {
+			auto v = LuaObject::checkValue<T*>(L, i);
+			if (!v) luaL_error(L, "arg %d expect %s", i, Components::name());
+			return v;
+		}
+
+		// out = a op b, b is struct or number, out may be same as a or b
+		template<class Op>
+		static void apply(lua_State* L, T* out, T* a, int b) {
+			if (lua_isnumber(L, b)) {
+				float s = (float)lua_tonumber(L, b);
+				for (int i = 0; i < Components::Num; i++)
+					Components::get(*out, i) = Op::apply(Components::get(*a, i), s);
+			}
+			else {
+				T* bv = checkStruct(L, b);
+				for (int i = 0; i < Components::Num; i++)
+					Components::get(*out, i) = Op::apply(Components::get(*a, i), Components::get(*bv, i));
+			}
+		}
+
+		// self:XXXInPlace(o), return self
+		template<class Op>
+		static int inPlace(lua_State* L) {
+			T* self = checkStruct(L, 1);
+			apply<Op>(L, self, self, 2);
+			lua_settop(L, 1);
+			return 1;
+		}
+
+		// T.XXX(out, a, b), return out
+		template<class Op>
+		static int toOut(lua_State* L) {
+			T* out = checkStruct(L, 1);
+			apply<Op>(L, out, checkStruct(L, 2), 3);
+			lua_settop(L, 1);
+			return 1;
+		}
+
+		static int Set(lua_State* L) {
+			T* self = checkStruct(L, 1);
+			for (int i = 0; i < Components::Num; i++)
+				Components::get(*self, i) = LuaObject::checkValue<float>(L, i + 2);
+			return 0;
+		}
+
+		static int Unpack(lua_State* L) {
+			T* self = checkStruct(L, 1);
+			for (int i = 0; i < Components::Num; i++)
+				lua_pushnumber(L, Components::get(*self, i));
+			return Components::Num;
+		}
+
+		// should be called after newType, methods generated later with same name take priority
+		static void bind(lua_State* L) {
+			LuaObject::addMethod(L, "Set", Set, true);
+			LuaObject::addMethod(L, "Unpack", Unpack, true);
+			LuaObject::addMethod(L, "AddInPlace", inPlace<Add>, true);
+			LuaObject::addMethod(L, "SubInPlace", inPlace<Sub>, true);
+			LuaObject::addMethod(L, "MulInPlace", inPlace<Mul>, true);
+			LuaObject::addMethod(L, "DivInPlace", inPlace<Div>, true);
+			LuaObject::addMethod(L, "Add", toOut<Add>, false);
+			LuaObject::addMethod(L, "Sub", toOut<Sub>, false);
+			LuaObject::addMethod(L, "Mul", toOut<Mul>, false);
+			LuaObject::addMethod(L, "Div", toOut<Div>, false);
+		}
+	};
+
+}
@@ -14,16 +14,57 @@
 
 #include "LuaMemoryProfile.h"
 #include "LuaState.h"
+#include "LuaPoolAllocator.h"
 #include "Log.h"
 #include "lua/lstate.h"
+#include "lua/ldebug.h"
+#include <cmath>
 namespace NS_SLUA {
 
 	// only calc memory alloc from lua script
 	// not include alloc from lua vm
+	// estimated from samples if sampling is on
 	size_t totalMemory;
 	
     bool memTrack = false;
-	MemoryDetail memoryRecord;
+	// average bytes between two sampled allocations, 0 records every allocation
+	int32 sampleBytes = 0;
+	int64 bytesToSample = 0;
+
+	// allocation site, proto and line of lua code, source is kept to tell reused proto
+	struct MemSiteKey {
+		const void* proto;
+		const void* source;
+		int32 line;
+
+		bool operator==(const MemSiteKey& other) const {
+			return proto == other.proto && source == other.source && line == other.line;
+		}
+		friend uint32 GetTypeHash(const MemSiteKey& key) {
+			return HashCombine(HashCombine(PointerHash(key.proto), PointerHash(key.source)), GetTypeHash(key.line));
+		}
+	};
+
+	struct MemSite {
+		// copied once when site is first seen, formatted only by report
+		FString source;
+		int32 line;
+		int64 liveBytes;
+		int64 totalBytes;
+		int32 count;
+	};
+
+	struct MemSample {
+		int32 site;
+		// bytes represented by the sample
+		int64 weight;
+	};
+
+	TMap<MemSiteKey, int32> siteIndices;
+	TArray<MemSite> memSites;
+	TMap<void*, MemSample> memSamples;
+	// lua objects may be freed by background task in multi-thread gc mode
+	FCriticalSection memoryRecordLock;
 
 	int LuaMemInfo::push(lua_State * L) const
 	{
@@ -37,46 +78,94 @@ namespace NS_SLUA {
 		return 1;
 	}
 
-	bool getMemInfo(lua_State* L, void* ptr, size_t size, LuaMemInfo& info);
+	// first lua function on stack not from slua, without lua_getinfo
+	static int32 captureSite(lua_State* L) {
+		for (CallInfo* ci = L->ci; ci != &L->base_ci; ci = ci->previous) {
+			if (!isLua(ci))
+				continue;
+			Proto* p = clLvalue(ci->func)->p;
+			const char* source = p->source ? getstr(p->source) : "=?";
+			if (strcmp(source, SLUA_LUACODE) == 0)
+				continue;
+
+			MemSiteKey key = { p, p->source, getfuncline(p, pcRel(ci->u.l.savedpc, p)) };
+			if (int32* index = siteIndices.Find(key))
+				return *index;
+			MemSite site = { UTF8_TO_TCHAR(source), key.line, 0, 0, 0 };
+			return siteIndices.Add(key, memSites.Add(site));
+		}
+		return INDEX_NONE;
+	}
+
+	// exponential distance to next sample, allocations are sampled as poisson process of bytes
+	static int64 nextSampleDistance() {
+		return (int64)(-FMath::Loge(1.0f - FMath::FRand()) * sampleBytes) + 1;
+	}
 
 	inline void addRecord(LuaState* LS, void* ptr, size_t size) {
-		if (!memTrack) return;
 		// skip if lua_State is null, lua_State hadn't binded to LS
 		lua_State* L = LS->getLuaState();
 		if (!L) return;
 
-		LuaMemInfo memInfo;
-		if (getMemInfo(L, ptr, size, memInfo)) {
-			// Log::Log("alloc memory %d from %s",size,TCHAR_TO_UTF8(*memInfo.hint));
-			memoryRecord.Add(ptr, memInfo);
-			totalMemory += size;
+		int64 weight = size;
+		if (sampleBytes > 0) {
+			bytesToSample -= size;
+			if (bytesToSample > 0) return;
+			bytesToSample = nextSampleDistance();
+			// unbiased estimate of bytes represented by the sample,
+			// expm1 keeps precision when size is much smaller than sampleBytes
+			weight = (int64)(size / -std::expm1(-(double)size / sampleBytes));
 		}
+
+		FScopeLock lock(&memoryRecordLock);
+		int32 site = captureSite(L);
+		if (site == INDEX_NONE) return;
+		MemSite& memSite = memSites[site];
+		memSite.liveBytes += weight;
+		memSite.totalBytes += weight;
+		memSite.count++;
+		memSamples.Add(ptr, MemSample{ site, weight });
+		totalMemory += weight;
 	}
 
 	inline void removeRecord(LuaState* LS, void* ptr, size_t osize) {
-		if (!memTrack) return;
-		// if ptr record 
-		if (memoryRecord.Remove(ptr)) {
-			// Log::Log("free memory %p size %d", ptr, osize);
-			totalMemory -= osize;
+		FScopeLock lock(&memoryRecordLock);
+		MemSample sample;
+		if (memSamples.RemoveAndCopyValue(ptr, sample)) {
+			memSites[sample.site].liveBytes -= sample.weight;
+			totalMemory -= sample.weight;
 		}
 	}
 
     void* LuaMemoryProfile::alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
         LuaState* ls = (LuaState*)ud;
+		LuaPoolAllocator* pool = ls->getPoolAllocator();
         if (nsize == 0) {
-            removeRecord(ls, ptr, osize);
-            FMemory::Free(ptr);
+            if (memTrack) removeRecord(ls, ptr, osize);
+			if (pool) pool->realloc(ptr, osize, 0);
+			else FMemory::Free(ptr);
             return NULL;
         }
         else {
-			if(ptr) removeRecord(ls, ptr, osize);
-            ptr = FMemory::Realloc(ptr,nsize);
-            addRecord(ls,ptr,nsize);
+			if (ptr && memTrack) removeRecord(ls, ptr, osize);
+			// osize is type of object if ptr is null, pool allocator ignores it
+			ptr = pool ? pool->realloc(ptr, osize, nsize) : FMemory::Realloc(ptr,nsize);
+			if (memTrack) addRecord(ls, ptr, nsize);
             return ptr;
         }
     }
 
+	void* LuaMemoryProfile::freeAsync(void *ud, void *ptr, size_t osize, size_t nsize) {
+		check(nsize == 0);
+		LuaState* ls = (LuaState*)ud;
+		if (memTrack) removeRecord(ls, ptr, osize);
+		// block of pool is handed back to game thread
+		LuaPoolAllocator* pool = ls->getPoolAllocator();
+		if (pool) pool->freeRemote(ptr, osize);
+		else FMemory::Free(ptr);
+		return NULL;
+	}
+
 	size_t LuaMemoryProfile::total()
 	{
 		return totalMemory;
@@ -84,6 +173,21 @@ namespace NS_SLUA {
 
 	void LuaMemoryProfile::start()
 	{
+		startSampling(0);
+	}
+
+	void LuaMemoryProfile::startSampling(int32 bytes)
+	{
+		FScopeLock lock(&memoryRecordLock);
+		sampleBytes = FMath::Max(bytes, 0);
+		bytesToSample = sampleBytes > 0 ? nextSampleDistance() : 0;
+		// frees are not seen while stopped, records before are stale
+		if (!memTrack) {
+			memSamples.Empty();
+			siteIndices.Empty();
+			memSites.Empty();
+			totalMemory = 0;
+		}
         memTrack = true;
 	}
 
@@ -92,44 +196,60 @@ namespace NS_SLUA {
 		memTrack = false;
 	}
 
-	const MemoryDetail& LuaMemoryProfile::memDetail()
+	void LuaMemoryProfile::memDetail(TArray<LuaMemInfo>& out)
 	{
-		return memoryRecord;
-	}
-
-    bool getMemInfo(lua_State* L, void* ptr, size_t size, LuaMemInfo& info) {
-        lua_Debug ar;
-		for (int i = 0;;i++) {
-			if (lua_getstack(L, i, &ar) && lua_getinfo(L, "nSl", &ar)) {
-				CallInfo* ci = (CallInfo*)ar.i_ci;
-                if (!isLua(ci))
-					continue;
-    
-                if (strcmp(ar.source, SLUA_LUACODE) == 0)
-                    continue;
-                
-				if (strcmp(ar.what, "Lua") == 0 || strcmp(ar.what, "main") == 0) {
-					info.ptr = ptr;
-					info.size = size;
-					info.hint = FString::Printf(TEXT("%s:%d"), UTF8_TO_TCHAR(ar.source), ar.currentline);
-					return true;
-				}
-			}
-            else break;
+		FScopeLock lock(&memoryRecordLock);
+		out.Reset(memSites.Num());
+		for (auto& site : memSites) {
+			if (site.liveBytes <= 0) continue;
+			LuaMemInfo info;
+			info.hint = FString::Printf(TEXT("%s:%d"), *site.source, site.line);
+			info.size = (int)site.liveBytes;
+			info.ptr = nullptr;
+			out.Add(MoveTemp(info));
 		}
-		return false;
-    }
+	}
 
 #if WITH_EDITOR
 	void dumpMemoryDetail()
 	{
-		Log::Log("Total memory alloc %d bytes", totalMemory);
-		for (auto& it : memoryRecord) {
-			auto& memInfo = it.Value;
-			Log::Log("Memory alloc %d from %s", memInfo.size, TCHAR_TO_UTF8(*memInfo.hint));
+		FScopeLock lock(&memoryRecordLock);
+		Log::Log("Total memory alloc %d bytes, sample bytes %d", (int)totalMemory, sampleBytes);
+		for (auto& site : memSites) {
+			if (site.count == 0) continue;
+			Log::Log("Memory alloc %lld bytes live, %lld bytes total in %d samples from %s:%d",
+				site.liveBytes, site.totalBytes, site.count, TCHAR_TO_UTF8(*site.source), site.line);
 		}
 	}
 
+	void startMemorySampling(const TArray<FString>& args)
+	{
+		LuaMemoryProfile::startSampling(args.Num() > 0 ? FCString::Atoi(*args[0]) : 512 * 1024);
+	}
+
+	void dumpPoolStats()
+	{
+		LuaState* ls = LuaState::get();
+		if (!ls || !ls->getPoolAllocator()) {
+			Log::Log("Pool allocator isn't enabled");
+			return;
+		}
+		auto& stats = ls->getPoolAllocator()->getStats();
+		Log::Log("Pool pages %d bytes, large blocks %d bytes in %llu allocs",
+			(int)stats.pageBytes, (int)stats.largeBytes, (unsigned long long)stats.largeAllocs);
+		for (auto& cs : stats.classes) {
+			if (cs.allocs == 0) continue;
+			Log::Log("Block %d: live %d bytes, peak %d bytes, pages %d bytes, %llu allocs",
+				(int)cs.blockSize, (int)cs.liveBytes, (int)cs.peakBytes, (int)cs.pageBytes, (unsigned long long)cs.allocs);
+		}
+	}
+
+	static FAutoConsoleCommand CVarDumpPoolStats(
+		TEXT("slua.DumpPoolStats"),
+		TEXT("Dump size class counters of lua pool allocator"),
+		FConsoleCommandDelegate::CreateStatic(dumpPoolStats),
+		ECVF_Cheat);
+
 	static FAutoConsoleCommand CVarDumpMemoryDetail(
 		TEXT("slua.DumpMemoryDetail"),
 		TEXT("Dump memory datail information"),
@@ -142,6 +262,12 @@ namespace NS_SLUA {
 		FConsoleCommandDelegate::CreateStatic(LuaMemoryProfile::stop),
 		ECVF_Cheat);
 
+	static FAutoConsoleCommand CVarStartMemSampling(
+		TEXT("slua.StartMemorySampling"),
+		TEXT("Start track memory info by sampling, arg is average bytes between samples"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(startMemorySampling),
+		ECVF_Cheat);
+
 	static FAutoConsoleCommand CVarStartMemTrack(
 		TEXT("slua.StartMemoryTrack"),
 		TEXT("Start track memory info"),
@@ -35,17 +35,22 @@ namespace NS_SLUA {
         return Ar;
     }
 
-	typedef TMap<void*, LuaMemInfo> MemoryDetail;
 //#endif
 
     class LuaMemoryProfile {
     public:
         static void* alloc (void *ud, void *ptr, size_t osize, size_t nsize);
+		// used by lua_freegarbage on background task, only frees
+		static void* freeAsync (void *ud, void *ptr, size_t osize, size_t nsize);
 		static size_t total();
 //#if WITH_EDITOR
+		// record every allocation
 		static void start();
+		// record one allocation per average bytes, allocation sites are aggregated
+		static void startSampling(int32 bytes);
 		static void stop();
-		static const MemoryDetail& memDetail();       
+		// live bytes of each allocation site, hint is formatted here
+		static void memDetail(TArray<LuaMemInfo>& out);
 //#endif
     };
 
@@ -28,6 +28,7 @@
 #include "LuaWidgetTree.h"
 #include "LuaArray.h"
 #include "LuaMap.h"
+#include "LuaSet.h"
 #include "Log.h"
 #include "LuaState.h"
 #include "LuaWrapper.h"
@@ -76,23 +77,71 @@ namespace NS_SLUA {
 
     // construct lua struct
 	// LuaStruct캯
-    LuaStruct::LuaStruct(uint8* b,uint32 s,UScriptStruct* u)
-        :buf(b),size(s),uss(u) {
+    LuaStruct::LuaStruct(uint8* b,uint32 s,UScriptStruct* u,bool r)
+        :buf(b),size(s),uss(u),isRef(r),index(INDEX_NONE) {
     }
 
 	// LuaStruct
     LuaStruct::~LuaStruct() {
-		if (buf) {
+		if (buf && !isRef) {
 			uss->DestroyStruct(buf);
-			FMemory::Free(buf);
+			freeBuffer(buf, size);
 			buf = nullptr;
 		}
     }
 
+	// free list of struct buffers for each size class, buffers larger than MaxSize aren't pooled
+	// 16ֽڷּĿб
+	struct LuaStructPool {
+		enum { Granularity = 16, MaxSize = 512, MaxFree = 256 };
+		TArray<uint8*> freeLists[MaxSize / Granularity];
+	};
+
+	static LuaStructPool structPool;
+
+	void LuaStruct::releaseBufferPool() {
+		for (auto& freeList : structPool.freeLists) {
+			for (auto buf : freeList)
+				FMemory::Free(buf);
+			freeList.Empty();
+		}
+	}
+
+	uint8* LuaStruct::allocBuffer(uint32 size) {
+		if (size > LuaStructPool::MaxSize)
+			return (uint8*)FMemory::Malloc(size);
+		auto& freeList = structPool.freeLists[(size - 1) / LuaStructPool::Granularity];
+		if (freeList.Num() > 0)
+			return freeList.Pop(false);
+		return (uint8*)FMemory::Malloc(Align(size, (uint32)LuaStructPool::Granularity));
+	}
+
+	void LuaStruct::freeBuffer(uint8* buf, uint32 size) {
+		if (size <= LuaStructPool::MaxSize) {
+			auto& freeList = structPool.freeLists[(size - 1) / LuaStructPool::Granularity];
+			if (freeList.Num() < LuaStructPool::MaxFree) {
+				freeList.Add(buf);
+				return;
+			}
+		}
+		FMemory::Free(buf);
+	}
+
 	// 
 	void LuaStruct::AddReferencedObjects(FReferenceCollector& Collector) {
 		Collector.AddReferencedObject(uss);
-		LuaReference::addRefByStruct(Collector, uss, buf);
+		// referenced struct is collected by its owner
+		if (!isRef)
+			LuaReference::addRefByStruct(Collector, uss, buf);
+	}
+
+	void LuaStruct::detach() {
+		if (!isRef) return;
+		uint8* copy = allocBuffer(size);
+		uss->InitializeStruct(copy);
+		uss->CopyScriptStruct(copy, buf);
+		buf = copy;
+		isRef = false;
 	}
 
     void LuaObject::addExtensionMethod(UClass* cls,const char* n,lua_CFunction func,bool isStatic) {
@@ -362,6 +411,22 @@ namespace NS_SLUA {
 		else return strcmp(name,tn)==0;
 	}
 
+	// tag in class metatable, identify it's an UObject metatable
+	static int ClassMetatableTag = 0;
+
+	void* LuaObject::testUserdata(lua_State* L, int p, const char* tn) {
+		void* ud = luaL_testudata(L, p, tn);
+		if (ud || strcmp(tn, "UObject") != 0)
+			return ud;
+		// maybe an UObject with class metatable
+		ud = lua_touserdata(L, p);
+		if (!ud || lua_type(L, p) != LUA_TUSERDATA || !lua_getmetatable(L, p))
+			return nullptr;
+		bool isClassMT = lua_rawgetp(L, -1, &ClassMetatableTag) != LUA_TNIL;
+		lua_pop(L, 2); // pop tag and metatable
+		return isClassMT ? ud : nullptr;
+	}
+
     LuaObject::PushPropertyFunction LuaObject::getPusher(UClass* cls) {
         auto it = pusherMap.Find(cls);
         if(it!=nullptr)
@@ -415,41 +480,47 @@ namespace NS_SLUA {
         return 0;
     }
 
+	// ѯչֶ UClass
+	ExtensionField* findExtensionField(UClass* cls, const char* name, bool isStatic) {
+		// search class and its super
+		TMap<FString, ExtensionField>* mapptr = nullptr;
+		while (cls != nullptr) {
+			mapptr = isStatic ? extensionMMap_static.Find(cls) : extensionMMap.Find(cls);
+			if (mapptr != nullptr) {
+				// find field
+				auto fieldptr = mapptr->Find(name);
+				if (fieldptr != nullptr)
+					return fieldptr;
+			}
+			// Ҳʹӻ
+			cls = cls->GetSuperClass();
+		}
+		return nullptr;
+	}
+
 	// ѯչ UClass
     int searchExtensionMethod(lua_State* L,UClass* cls,const char* name,bool isStatic=false) {
-
-        // search class and its super
-        TMap<FString,ExtensionField>* mapptr=nullptr;
-        while(cls!=nullptr) {
-            mapptr = isStatic?extensionMMap_static.Find(cls):extensionMMap.Find(cls);
-            if(mapptr!=nullptr) {
-                // find field
-                auto fieldptr = mapptr->Find(name);
-				if (fieldptr != nullptr) {
-					// is function
-					if (fieldptr->isFunction) {
-						lua_pushcfunction(L, fieldptr->func);
-						return 1;
-					} 
-					// is property
-					else {
-						if (!fieldptr->getter) luaL_error(L, "Property %s is set only", name);
-						lua_pushcfunction(L, fieldptr->getter);
-						if (!isStatic) {
-							lua_pushvalue(L, 1); // push self
-							// ڶΪ
-							// : ʵҪselfȥ
-							lua_call(L, 1, 1);
-						} else 
-							lua_call(L, 0, 1);
-						return 1;
-					}
-				}
-            }
-        	// Ҳʹӻ
-            cls=cls->GetSuperClass();
-        }   
-        return 0;
+		auto fieldptr = findExtensionField(cls, name, isStatic);
+		if (fieldptr == nullptr)
+			return 0;
+		// is function
+		if (fieldptr->isFunction) {
+			lua_pushcfunction(L, fieldptr->func);
+			return 1;
+		} 
+		// is property
+		else {
+			if (!fieldptr->getter) luaL_error(L, "Property %s is set only", name);
+			lua_pushcfunction(L, fieldptr->getter);
+			if (!isStatic) {
+				lua_pushvalue(L, 1); // push self
+				// ڶΪ
+				// : ʵҪselfȥ
+				lua_call(L, 1, 1);
+			} else 
+				lua_call(L, 0, 1);
+			return 1;
+		}
     }
 
 	// ѯչ UObject
@@ -475,7 +546,7 @@ namespace NS_SLUA {
         	// MinAlignmentΪ1
             uint32 size = uss->GetStructureSize() ? uss->GetStructureSize() : 1;
             
-            uint8* buf = (uint8*)FMemory::Malloc(size);
+            uint8* buf = LuaStruct::allocBuffer(size);
             uss->InitializeStruct(buf);
             LuaStruct* ls=new LuaStruct(buf,size,uss);
             LuaObject::push(L,ls);
@@ -537,6 +608,158 @@ namespace NS_SLUA {
         }
     }
 
+	// build marshalling plan with same rules as fillParam and returnValue
+	static void compileCallPlan(UFunction* func, LuaObject::FuncCallPlan& plan) {
+		typedef LuaObject::FuncCallPlan FuncCallPlan;
+		plan.func = func;
+		plan.params.Reset();
+		plan.returnIndex = INDEX_NONE;
+		plan.isLatent = false;
+		plan.needInit = false;
+		plan.needDestroy = false;
+
+		// check flags of each property, links of UStruct leave out properties owned by native class
+		// ԱжϲǷҪ
+		for (TFieldIterator<UProperty> it(func); it; ++it) {
+			uint64 propflag = it->GetPropertyFlags();
+			if (!(propflag & CPF_ZeroConstructor))
+				plan.needInit = true;
+			if (!(propflag & (CPF_IsPlainOldData | CPF_NoDestructor)))
+				plan.needDestroy = true;
+		}
+
+		bool isNative = (func->FunctionFlags & EFunctionFlags::FUNC_Native) != 0;
+		for (TFieldIterator<UProperty> it(func); it && (it->PropertyFlags&CPF_Parm); ++it) {
+			UProperty* prop = *it;
+			uint64 propflag = prop->GetPropertyFlags();
+			FuncCallPlan::Param param;
+			param.prop = prop;
+			param.offset = prop->GetOffset_ForInternal();
+			param.checker = LuaObject::getChecker(prop);
+			param.pusher = LuaObject::getPusher(prop);
+			param.flags = 0;
+
+			// native function skip return value, others skip real out params
+			bool isInput = isNative ? !(propflag&CPF_ReturnParm) : !IsRealOutParam(propflag);
+			if (prop->GetFName() == NAME_LatentInfo) {
+				param.flags |= FuncCallPlan::PF_LatentInfo;
+				plan.isLatent = true;
+			}
+			else {
+				if (isInput) param.flags |= FuncCallPlan::PF_Input;
+				if (propflag&CPF_OutParm) param.flags |= FuncCallPlan::PF_OutParm;
+				if (propflag&CPF_ReturnParm) {
+					param.flags |= FuncCallPlan::PF_Return;
+					plan.returnIndex = plan.params.Num();
+				}
+				else if (IsRealOutParam(propflag))
+					param.flags |= FuncCallPlan::PF_Output;
+			}
+			plan.params.Add(param);
+		}
+	}
+
+	const LuaObject::FuncCallPlan* LuaObject::getCallPlan(lua_State* L, UFunction* func) {
+		auto ls = LuaState::get(L);
+		auto cached = ls->callPlans.Find(func);
+		// address of freed function may be reused before engine gc callback
+		if (cached && (*cached)->func.Get() == func)
+			return cached->Get();
+
+		FuncCallPlan* plan = cached ? cached->Get() : new FuncCallPlan;
+		compileCallPlan(func, *plan);
+		if (!cached) ls->callPlans.Add(func, TUniquePtr<FuncCallPlan>(plan));
+		return plan;
+	}
+
+	void LuaObject::fillParam(lua_State* L, int i, const FuncCallPlan* plan, uint8* params) {
+		for (const FuncCallPlan::Param& param : plan->params) {
+			if (param.flags & FuncCallPlan::PF_LatentInfo) {
+				// bind a callback to the latent function
+				lua_State *mainThread = G(L)->mainthread;
+
+				ULatentDelegate *obj = LuaObject::getLatentDelegate(mainThread);
+				int threadRef = obj->getThreadRef(L);
+				FLatentActionInfo LatentActionInfo(threadRef, GetTypeHash(FGuid::NewGuid()), *ULatentDelegate::NAME_LatentCallback, obj);
+
+				param.prop->CopySingleValue(params + param.offset, &LatentActionInfo);
+				continue;
+			}
+			if (!(param.flags & FuncCallPlan::PF_Input))
+				continue;
+
+			// out param can be nil
+			if ((param.flags & FuncCallPlan::PF_OutParm) && lua_isnil(L, i)) {
+				i++;
+				continue;
+			}
+			if (!param.checker) {
+				FString tn = param.prop->GetClass()->GetName();
+				luaL_error(L, "unsupport param type %s at %d", TCHAR_TO_UTF8(*tn), i);
+			}
+			param.checker(L, param.prop, params + param.offset, i);
+			i++;
+		}
+	}
+
+	int LuaObject::returnValue(lua_State* L, const FuncCallPlan* plan, uint8* params) {
+		int ret = 0;
+		// put return value as head
+		if (plan->returnIndex != INDEX_NONE) {
+			const FuncCallPlan::Param& param = plan->params[plan->returnIndex];
+			if (param.pusher)
+				ret += param.pusher(L, param.prop, params + param.offset, true);
+			else
+				ret += LuaObject::push(L, param.prop, params + param.offset);
+		}
+
+		// push out params
+		for (const FuncCallPlan::Param& param : plan->params) {
+			if (!(param.flags & FuncCallPlan::PF_Output))
+				continue;
+			if (param.pusher)
+				ret += param.pusher(L, param.prop, params + param.offset, true);
+			else
+				ret += LuaObject::push(L, param.prop, params + param.offset);
+		}
+
+		if (plan->isLatent)
+			return lua_yield(L, ret);
+		return ret;
+	}
+
+	FuncParamsScope::FuncParamsScope(UFunction* f)
+		: FuncParamsScope(f, true, true)
+	{
+	}
+
+	FuncParamsScope::FuncParamsScope(UFunction* f, bool needInit, bool destroy)
+		: func(f)
+		, needDestroy(destroy)
+	{
+		// same size as FStructOnScope, rpc invoke of script function need its locals
+		int32 size = func->GetStructureSize();
+		if (size <= InlineSize && func->GetMinAlignment() <= InlineAlignment)
+			params = reinterpret_cast<uint8*>(&inlineBuffer);
+		else
+			params = reinterpret_cast<uint8*>(FMemory::Malloc(size, func->GetMinAlignment()));
+
+		// InitializeStruct zeroes memory first, zero constructed params needn't more
+		// ֻзʼĲҪ
+		if (needInit)
+			func->InitializeStruct(params);
+		else
+			FMemory::Memzero(params, size);
+	}
+
+	FuncParamsScope::~FuncParamsScope()
+	{
+		if (needDestroy)
+			func->DestroyStruct(params);
+		if (params != reinterpret_cast<uint8*>(&inlineBuffer))
+			FMemory::Free(params);
+	}
+
 	void LuaObject::callRpc(lua_State* L, UObject* obj, UFunction* func, uint8* params) {
 		// call rpc without outparams
     	// ûзֵ
@@ -625,14 +848,15 @@ namespace NS_SLUA {
         
         UFunction* func = reinterpret_cast<UFunction*>(ud);
         
-		FStructOnScope params(func);
-		LuaObject::fillParam(L, offset, func, params.GetStructMemory());
+		auto plan = LuaObject::getCallPlan(L, func);
+		FuncParamsScope params(func, plan->needInit, plan->needDestroy);
+		LuaObject::fillParam(L, offset, plan, params.get());
 		{
-			LuaObject::callUFunction(L, obj, func, params.GetStructMemory());
+			LuaObject::callUFunction(L, obj, func, params.get());
 		}
 		// return value to push lua stack
     	// ֵѹջ
-		return LuaObject::returnValue(L, func, params.GetStructMemory());
+		return LuaObject::returnValue(L, plan, params.get());
     }
 
     // find ufunction from cache
@@ -659,6 +883,71 @@ namespace NS_SLUA {
 		state->classMap.cacheProp(cls, pname, property);
     }
 
+	// get name at index p if it's a short string, short string is interned by lua,
+	// so its address is unique for same content
+	static const char* getInternedName(lua_State* L, int p) {
+		if (lua_type(L, p) != LUA_TSTRING) return nullptr;
+		size_t len;
+		const char* name = lua_tolstring(L, p, &len);
+		return len <= LUAI_MAXSHORTLEN ? name : nullptr;
+	}
+
+	const CacheMember* LuaObject::findCacheMember(lua_State* L, UClass* cls, int p)
+	{
+		const char* name = getInternedName(L, p);
+		if (!name) return nullptr;
+		auto state = LuaState::get(L);
+		return state->classMap.findMember(cls, name);
+	}
+
+	void LuaObject::cacheMember(lua_State* L, UClass* cls, int p, const CacheMember& member)
+	{
+		p = lua_absindex(L, p);
+		const char* name = getInternedName(L, p);
+		if (!name) return;
+		auto state = LuaState::get(L);
+		// anchor name to keep its address valid while cached
+		lua_geti(L, LUA_REGISTRYINDEX, state->memberNameRef);
+		lua_pushvalue(L, p);
+		lua_pushboolean(L, true);
+		lua_rawset(L, -3);
+		lua_pop(L, 1);
+		state->classMap.cacheMember(cls, name, member);
+	}
+
+	// push cached member of obj at index 1, return -1 if member had been invalid
+	static int pushCacheMember(lua_State* L, UObject* obj, const CacheMember& member) {
+		switch (member.kind) {
+		case CacheMember::Property:
+			if (UField* field = member.field.Get())
+				return LuaObject::push(L, (UProperty*)field, obj, false);
+			return -1;
+		case CacheMember::Function:
+			if (UField* field = member.field.Get())
+				return LuaObject::push(L, (UFunction*)field);
+			return -1;
+		case CacheMember::ExtensionMethod:
+			lua_pushcfunction(L, member.func);
+			return 1;
+		case CacheMember::ExtensionProperty:
+			lua_pushcfunction(L, member.func);
+			lua_pushvalue(L, 1); // push self
+			lua_call(L, 1, 1);
+			return 1;
+		}
+		return -1;
+	}
+
+	// cache member of cls named at index 2 and push it
+	static int cacheAndPushMember(lua_State* L, UObject* obj, UClass* cls, CacheMember::Kind kind, UField* field, lua_CFunction func = nullptr) {
+		CacheMember member;
+		member.kind = kind;
+		member.field = field;
+		member.func = func;
+		LuaObject::cacheMember(L, cls, 2, member);
+		return pushCacheMember(L, obj, member);
+	}
+
 	// cache class property's
 	// class
 	void cachePropertys(lua_State* L, UClass* cls) {
@@ -674,18 +963,25 @@ namespace NS_SLUA {
         const char* name = LuaObject::checkValue<const char*>(L, 2);
 
 		UClass* cls = obj->GetClass();
+		// resolve member by interned name, skip string conversion
+		// ͨڻַѯԱ
+		if (auto member = LuaObject::findCacheMember(L, cls, 2)) {
+			int ret = pushCacheMember(L, obj, *member);
+			if (ret >= 0) return ret;
+		}
+
     	// UProperty
         UProperty* up = LuaObject::findCacheProperty(L, cls, name);
         if (up)
         {
-            return LuaObject::push(L, up, obj, false);
+            return cacheAndPushMember(L, obj, cls, CacheMember::Property, up);
         }
 
     	// UFunction
         UFunction* func = LuaObject::findCacheFunction(L, cls, name);
         if (func)
         {
-            return LuaObject::push(L, func);
+            return cacheAndPushMember(L, obj, cls, CacheMember::Function, func);
         }
 
         // get blueprint member
@@ -697,15 +993,20 @@ namespace NS_SLUA {
 
 			up = LuaObject::findCacheProperty(L, cls, name);
             if (up) {
-                return LuaObject::push(L, up, obj, false);
+                return cacheAndPushMember(L, obj, cls, CacheMember::Property, up);
             }
             
             // search extension method
+			auto fieldptr = findExtensionField(cls, name, false);
+			if (fieldptr && fieldptr->isFunction)
+				return cacheAndPushMember(L, obj, cls, CacheMember::ExtensionMethod, nullptr, fieldptr->func);
+			else if (fieldptr && fieldptr->getter)
+				return cacheAndPushMember(L, obj, cls, CacheMember::ExtensionProperty, nullptr, fieldptr->getter);
             return searchExtensionMethod(L, obj, name);
         }
         else {
 			LuaObject::cacheFunction(L, cls, name, func);
-            return LuaObject::push(L,func);
+            return cacheAndPushMember(L, obj, cls, CacheMember::Function, func);
         }
     }
 
@@ -714,15 +1015,28 @@ namespace NS_SLUA {
         UObject* obj = LuaObject::checkValue<UObject*>(L, 1);
         const char* name = LuaObject::checkValue<const char*>(L, 2);
         UClass* cls = obj->GetClass();
-    	// UProperty
-		UProperty* up = LuaObject::findCacheProperty(L, cls, name);
+		UProperty* up = nullptr;
+		auto member = LuaObject::findCacheMember(L, cls, 2);
+		if (member && member->kind == CacheMember::Property)
+			up = (UProperty*)member->field.Get();
 		if (!up)
 		{
-			// ûеĻȼcache
-			cachePropertys(L, cls);
+	    	// UProperty
 			up = LuaObject::findCacheProperty(L, cls, name);
+			if (!up)
+			{
+				// ûеĻȼcache
+				cachePropertys(L, cls);
+				up = LuaObject::findCacheProperty(L, cls, name);
+			}
+			if (!up) luaL_error(L, "Property %s not found", name);
+
+			CacheMember newMember;
+			newMember.kind = CacheMember::Property;
+			newMember.field = up;
+			newMember.func = nullptr;
+			LuaObject::cacheMember(L, cls, 2, newMember);
 		}
-		if (!up) luaL_error(L, "Property %s not found", name);
     	// ͼɶ
         if(up->GetPropertyFlags() & CPF_BlueprintReadOnly)
             luaL_error(L,"Property %s is readonly",name);
@@ -734,6 +1048,224 @@ namespace NS_SLUA {
         return 0;
     }
 
+	// getter bound to class metatable, upvalue 1 is UProperty, upvalue 2 is pusher
+	static int classPropertyGetter(lua_State* L) {
+		UObject* obj = LuaObject::checkValue<UObject*>(L, 1);
+		if (!obj) luaL_error(L, "arg 1 expect UObject");
+		auto prop = reinterpret_cast<UProperty*>(lua_touserdata(L, lua_upvalueindex(1)));
+		auto pusher = reinterpret_cast<LuaObject::PushPropertyFunction>(lua_touserdata(L, lua_upvalueindex(2)));
+		// array and map have no pusher, they should be pushed with owner object
+		if (!pusher)
+			return LuaObject::push(L, prop, obj, false);
+		return pusher(L, prop, prop->ContainerPtrToValuePtr<uint8>(obj), false);
+	}
+
+	// setter bound to class metatable, upvalue 1 is UProperty, upvalue 2 is checker
+	static int classPropertySetter(lua_State* L) {
+		UObject* obj = LuaObject::checkValue<UObject*>(L, 1);
+		if (!obj) luaL_error(L, "arg 1 expect UObject");
+		auto prop = reinterpret_cast<UProperty*>(lua_touserdata(L, lua_upvalueindex(1)));
+		auto checker = reinterpret_cast<LuaObject::CheckPropertyFunction>(lua_touserdata(L, lua_upvalueindex(2)));
+		checker(L, prop, prop->ContainerPtrToValuePtr<uint8>(obj), 2);
+		return 0;
+	}
+
+	// __index of class metatable, upvalue 1 is getter table, upvalue 2 is method table
+	// Ԫ__index
+	static int classInstanceIndex(lua_State* L) {
+		lua_pushvalue(L, 2);
+		if (lua_gettable(L, lua_upvalueindex(1)) == LUA_TFUNCTION) {
+			lua_pushvalue(L, 1);
+			lua_call(L, 1, 1);
+			return 1;
+		}
+		lua_pop(L, 1);
+		lua_pushvalue(L, 2);
+		if (lua_gettable(L, lua_upvalueindex(2)) != LUA_TNIL)
+			return 1;
+		lua_pop(L, 1);
+		// interface function, extension method or member not bound
+		return instanceIndex(L);
+	}
+
+	// __newindex of class metatable, upvalue 1 is setter table
+	// Ԫ__newindex
+	static int classInstanceNewindex(lua_State* L) {
+		lua_pushvalue(L, 2);
+		if (lua_gettable(L, lua_upvalueindex(1)) == LUA_TFUNCTION) {
+			lua_pushvalue(L, 1);
+			lua_pushvalue(L, 3);
+			lua_call(L, 2, 0);
+			return 0;
+		}
+		lua_pop(L, 1);
+		return newinstanceIndex(L);
+	}
+
+	// bind members declared by cls to getter/setter/method table, members of super class are chained
+	// clsĳԱ,
+	static void bindClassMembers(lua_State* L, UClass* cls, int getters, int setters, int methods) {
+#if WITH_EDITOR
+		// blueprint class may be recompiled in editor and regenerate its members,
+		// leave them to instanceIndex which check members by weak ptr
+		if (!cls->HasAnyClassFlags(CLASS_Native))
+			return;
+#endif
+		for (TFieldIterator<UProperty> it(cls, EFieldIteratorFlags::ExcludeSuper); it; ++it) {
+			UProperty* prop = *it;
+			FTCHARToUTF8 name(*prop->GetName());
+			auto propCls = prop->GetClass();
+			bool pushWithOwner = propCls == UArrayProperty::StaticClass() || propCls == UMapProperty::StaticClass()
+				|| propCls == USetProperty::StaticClass() || propCls == UStructProperty::StaticClass();
+			auto pusher = pushWithOwner ? nullptr : LuaObject::getPusher(prop);
+			if (pusher || pushWithOwner) {
+				lua_pushlightuserdata(L, prop);
+				lua_pushlightuserdata(L, reinterpret_cast<void*>(pusher));
+				lua_pushcclosure(L, classPropertyGetter, 2);
+				lua_setfield(L, getters, name.Get());
+			}
+
+			auto checker = LuaObject::getChecker(prop);
+			if (checker && !(prop->GetPropertyFlags() & CPF_BlueprintReadOnly)) {
+				lua_pushlightuserdata(L, prop);
+				lua_pushlightuserdata(L, reinterpret_cast<void*>(checker));
+				lua_pushcclosure(L, classPropertySetter, 2);
+				lua_setfield(L, setters, name.Get());
+			}
+		}
+
+		for (TFieldIterator<UFunction> it(cls, EFieldIteratorFlags::ExcludeSuper); it; ++it) {
+			UFunction* func = *it;
+			LuaObject::push(L, func);
+			lua_setfield(L, methods, TCHAR_TO_UTF8(*func->GetName()));
+		}
+	}
+
+	void LuaObject::pushClassMetatable(lua_State* L, UClass* cls) {
+		auto ls = LuaState::get(L);
+		if (int* ref = ls->classMetatables.Find(cls)) {
+			lua_geti(L, LUA_REGISTRYINDEX, *ref);
+			return;
+		}
+
+		lua_newtable(L);
+		int mt = lua_gettop(L);
+		lua_pushstring(L, "UObject");
+		lua_setfield(L, mt, "__name");
+		lua_pushboolean(L, true);
+		lua_rawsetp(L, mt, &ClassMetatableTag);
+		lua_pushcfunction(L, gcObject);
+		lua_setfield(L, mt, "__gc");
+		lua_pushcfunction(L, objectToString);
+		lua_setfield(L, mt, "__tostring");
+
+		// create getter, setter and method table, chain them to super's
+		UClass* super = cls->GetSuperClass();
+		if (super) pushClassMetatable(L, super);
+		else lua_pushnil(L);
+		int superMt = lua_gettop(L);
+		const char* fields[] = { ".get", ".set", ".method" };
+		for (auto field : fields) {
+			lua_newtable(L);
+			if (super) {
+				lua_newtable(L);
+				lua_getfield(L, superMt, field);
+				lua_setfield(L, -2, "__index");
+				lua_setmetatable(L, -2);
+			}
+			lua_setfield(L, mt, field);
+		}
+		lua_pop(L, 1); // pop super metatable
+
+		lua_getfield(L, mt, ".get");
+		lua_getfield(L, mt, ".set");
+		lua_getfield(L, mt, ".method");
+		bindClassMembers(L, cls, mt + 1, mt + 2, mt + 3);
+
+		lua_pushvalue(L, mt + 1);
+		lua_pushvalue(L, mt + 3);
+		lua_pushcclosure(L, classInstanceIndex, 2);
+		lua_setfield(L, mt, "__index");
+		lua_pushvalue(L, mt + 2);
+		lua_pushcclosure(L, classInstanceNewindex, 1);
+		lua_setfield(L, mt, "__newindex");
+		lua_settop(L, mt);
+
+		// hold metatable for next push
+		lua_pushvalue(L, mt);
+		ls->classMetatables.Add(cls, luaL_ref(L, LUA_REGISTRYINDEX));
+	}
+
+	int LuaObject::pushObjectWithClassMT(lua_State* L, UObject* obj, bool ref) {
+		if (getFromCache(L, obj, "UObject") && !popStaleObjectHandle(L)) return 1;
+		pushObjectType(L, obj, nullptr, nullptr, 0);
+		pushClassMetatable(L, obj->GetClass());
+		lua_setmetatable(L, -2);
+		addRef(L, obj, lua_touserdata(L, -1), ref);
+		cacheObj(L, obj);
+		return 1;
+	}
+
+	int LuaObject::pushObjectType(lua_State* L, UObject* obj, const char* tn, lua_CFunction setupmt, int gc) {
+		if (!obj) {
+			lua_pushnil(L);
+			return 1;
+		}
+		GenericUserData* ud;
+		if (LuaState::get(L)->objectHandleEnabled) {
+			auto hud = reinterpret_cast<ObjectHandleUD*>(lua_newuserdata(L, sizeof(ObjectHandleUD)));
+			hud->index = GUObjectArray.ObjectToIndex(obj);
+			hud->serial = GUObjectArray.AllocateSerialNumber(hud->index);
+			hud->flag = UD_AUTOGC | UD_UOBJECT | UD_OBJHANDLE;
+			ud = hud;
+		}
+		else {
+			ud = reinterpret_cast<GenericUserData*>(lua_newuserdata(L, sizeof(GenericUserData)));
+			ud->flag = UD_AUTOGC | UD_UOBJECT;
+		}
+		ud->parent = nullptr;
+		ud->ud = obj;
+		// metatable is set by caller if tn is null
+		if (tn) setupMetaTable(L, tn, setupmt, gc);
+		return 1;
+	}
+
+	bool LuaObject::isObjectHandleValid(const void* p) {
+		auto ud = reinterpret_cast<const ObjectHandleUD*>(p);
+		// index is freed or reused by another object
+		FUObjectItem* item = GUObjectArray.IndexToObject(ud->index);
+		return item && item->Object == ud->ud && item->GetSerialNumber() == ud->serial;
+	}
+
+	bool LuaObject::popStaleObjectHandle(lua_State* L) {
+		auto ud = reinterpret_cast<GenericUserData*>(lua_touserdata(L, -1));
+		if (!ud || !(ud->flag & UD_OBJHANDLE))
+			return false;
+		if (!(ud->flag & UD_HADFREE) && isObjectHandleValid(ud))
+			return false;
+		// slot in cache will be overwritten by new userdata
+		LuaState::get(L)->releaseObjectHandle(ud);
+		lua_pop(L, 1);
+		return true;
+	}
+
+	bool LuaObject::releaseObjectHandle(lua_State* L, int p) {
+		auto ud = reinterpret_cast<GenericUserData*>(lua_touserdata(L, p));
+		if (!ud || !(ud->flag & UD_OBJHANDLE))
+			return false;
+		LuaState* ls = LuaState::get(L);
+		ls->releaseObjectHandle(ud);
+		// remove cache only if slot is cleared, it may hold a new userdata of same address
+		int32 slot = ls->objCache.find(ud->ud);
+		if (slot) {
+			lua_geti(L, LUA_REGISTRYINDEX, ls->cacheObjRef);
+			if (lua_rawgeti(L, -1, slot) == LUA_TNIL)
+				ls->objCache.remove(ud->ud);
+			lua_pop(L, 2);
+		}
+		return true;
+	}
+
 	// ͨNameStructе
 	UProperty* FindStructPropertyByName(UScriptStruct* scriptStruct, const char* name)
 	{
@@ -910,6 +1442,14 @@ namespace NS_SLUA {
 		return LuaMap::push(L, p->KeyProp, p->ValueProp, v);
     }
 
+	// USet
+	int pushUSetProperty(lua_State* L, UProperty* prop, uint8* parms, bool ref) {
+		auto p = Cast<USetProperty>(prop);
+		ensure(p);
+		FScriptSet* v = p->GetPropertyValuePtr(parms);
+		return LuaSet::push(L, p->ElementProp, v);
+	}
+
 	// UWeakObject
 	int pushUWeakProperty(lua_State* L, UProperty* prop, uint8* parms,bool ref) {
 		auto p = Cast<UWeakObjectProperty>(prop);
@@ -936,6 +1476,15 @@ namespace NS_SLUA {
 		return 0;
 	}
 
+	// USet index
+	int checkUSetProperty(lua_State* L, UProperty* prop, uint8* parms, int i) {
+		auto p = Cast<USetProperty>(prop);
+		ensure(p);
+		CheckUD(LuaSet, L, i);
+		LuaSet::clone((FScriptSet*)parms, p->ElementProp, UD->get());
+		return 0;
+	}
+
 	// UStruct
     int pushUStructProperty(lua_State* L,UProperty* prop,uint8* parms,bool ref) {
         auto p = Cast<UStructProperty>(prop);
@@ -947,14 +1496,14 @@ namespace NS_SLUA {
 			return 1;
 
     	// ͼ
-		if (uss->GetName() == "LuaBPVar") {
+		if (uss == FLuaBPVar::StaticStruct()) {
 			((FLuaBPVar*)parms)->value.push(L);
 			return 1;
 		}
 
     	// ½һ
 		uint32 size = uss->GetStructureSize() ? uss->GetStructureSize() : 1;
-		uint8* buf = (uint8*)FMemory::Malloc(size);
+		uint8* buf = LuaStruct::allocBuffer(size);
 		uss->InitializeStruct(buf);
 		uss->CopyScriptStruct(buf, parms);
 		return LuaObject::push(L, new LuaStruct(buf,size,uss));
@@ -1058,7 +1607,7 @@ namespace NS_SLUA {
 
 		// if it's LuaBPVar
     	// ͼ
-		if (uss->GetName() == "LuaBPVar")
+		if (uss == FLuaBPVar::StaticStruct())
 			return FLuaBPVar::checkValue(L, p, parms, i);
 
 		// skip first char to match type
@@ -1112,19 +1661,25 @@ namespace NS_SLUA {
     bool LuaObject::getFromCache(lua_State* L,void* obj,const char* tn,bool check) {
         LuaState* ls = LuaState::get(L);
         ensure(ls->cacheObjRef!=LUA_NOREF);
+        auto& cache = ls->objCache;
+        cache.lookupCount++;
+        // miss without touching lua
+        int32 slot = cache.find(obj);
+        if (!slot)
+            return false;
         lua_geti(L,LUA_REGISTRYINDEX,ls->cacheObjRef);
         // should be a table
         ensure(lua_type(L,-1)==LUA_TTABLE);
-        // push obj as key
-        lua_pushlightuserdata(L,obj);
-        // get key from table
-        lua_rawget(L,-2);
+        lua_rawgeti(L,-1,slot);
         lua_remove(L,-2); // remove cache table
         
+        // userdata had been collected by lua
         if(lua_isnil(L,-1)) {
             lua_pop(L,1);
+            cache.remove(obj);
 			return false;
         }
+        cache.hitCount++;
 		if (!check)
 			return true;
 		// check type of ud matched
@@ -1139,7 +1694,8 @@ namespace NS_SLUA {
 
     void LuaObject::removeRef(lua_State* L,UObject* obj) {
         auto sl = LuaState::get(L);
-        sl->unlinkUObject(obj);
+        // obj is still alive when its userdata is collected
+        sl->unlinkUObject(obj, true);
     }
 
 	void LuaObject::releaseLink(lua_State* L, void* prop) {
@@ -1154,25 +1710,18 @@ namespace NS_SLUA {
 
     void LuaObject::cacheObj(lua_State* L,void* obj) {
         LuaState* ls = LuaState::get(L);
+        int32 slot = ls->objCache.add(obj);
         lua_geti(L,LUA_REGISTRYINDEX,ls->cacheObjRef);
-        lua_pushlightuserdata(L,obj);
-        lua_pushvalue(L,-3); // obj userdata
-        lua_rawset(L,-3);
+        lua_pushvalue(L,-2); // obj userdata
+        lua_rawseti(L,-2,slot);
         lua_pop(L,1); // pop cache table        
     }
 
 	void LuaObject::removeFromCache(lua_State * L, void* obj)
 	{
-		// get cache table
+		// slot isn't cleared in lua, it's overwritten when reused
 		LuaState* ls = LuaState::get(L);
-		lua_geti(L, LUA_REGISTRYINDEX, ls->cacheObjRef);
-		ensure(lua_type(L, -1) == LUA_TTABLE);
-		lua_pushlightuserdata(L, obj);
-		lua_pushnil(L);
-		// cache[obj] = nil
-		lua_rawset(L, -3);
-		// pop cache table;
-		lua_pop(L, 1);
+		ls->objCache.remove(obj);
 	}
 
 	void LuaObject::deleteFGCObject(lua_State* L, FGCObject * obj)
@@ -1235,26 +1784,39 @@ namespace NS_SLUA {
 	}
 
     int LuaObject::gcObject(lua_State* L) {
+		if (releaseObjectHandle(L, 1)) return 0;
 		CheckUDGC(UObject,L,1);
         removeRef(L,UD);
         return 0;
     }
 
     int LuaObject::gcClass(lua_State* L) {
+		if (releaseObjectHandle(L, 1)) return 0;
 		CheckUDGC(UClass,L,1);
         removeRef(L,UD);
         return 0;
     }
 
     int LuaObject::gcStructClass(lua_State* L) {
+		if (releaseObjectHandle(L, 1)) return 0;
 		CheckUDGC(UScriptStruct,L,1);
         removeRef(L,UD);
         return 0;
     }
 
 	int LuaObject::gcStruct(lua_State* L) {
-		CheckUDGC(LuaStruct, L, 1);
-		deleteFGCObject(L,UD);
+		// struct reference of deleted owner is flagged freed, it must be deleted too,
+		// so don't check by CheckUDGC
+		// ͷŵĽṹҲҪɾ
+		auto udptr = reinterpret_cast<UserData<LuaStruct*>*>(lua_touserdata(L, 1));
+		if (!udptr || !udptr->ud) return 0;
+		LuaStruct* UD = udptr->ud;
+		// remove struct reference from link of its owner
+		releaseLink(L, udptr);
+		// not a FGCObject, delete it at once
+		LuaState::get(L)->removeStruct(UD);
+		delete UD;
+		udptr->ud = nullptr;
 		return 0;
 	}
 
@@ -1271,6 +1833,8 @@ namespace NS_SLUA {
 			return pushClass(L, c);
 		else if (auto s = Cast<UScriptStruct>(obj))
 			return pushStruct(L, s);
+		else if (LuaState::get(L)->classMetatableEnabled)
+			return pushObjectWithClassMT(L, obj, ref);
 		else
 			return pushGCObject<UObject*>(L,obj,"UObject",setupInstanceMT,gcObject,ref);
     }
@@ -1326,6 +1890,7 @@ namespace NS_SLUA {
         regPusher(UObjectProperty::StaticClass(),pushUObjectProperty);
         regPusher(UArrayProperty::StaticClass(),pushUArrayProperty);
         regPusher(UMapProperty::StaticClass(),pushUMapProperty);
+        regPusher(USetProperty::StaticClass(),pushUSetProperty);
         regPusher(UStructProperty::StaticClass(),pushUStructProperty);
 		regPusher(UEnumProperty::StaticClass(), pushEnumProperty);
 		regPusher(UClassProperty::StaticClass(), pushUClassProperty);
@@ -1350,6 +1915,7 @@ namespace NS_SLUA {
 
         regChecker(UArrayProperty::StaticClass(),checkUArrayProperty);
         regChecker(UMapProperty::StaticClass(),checkUMapProperty);
+        regChecker(USetProperty::StaticClass(),checkUSetProperty);
         regChecker(UDelegateProperty::StaticClass(),checkUDelegateProperty);
         regChecker(UStructProperty::StaticClass(),checkUStructProperty);
 		regChecker(UClassProperty::StaticClass(), checkUClassProperty);
@@ -1388,11 +1954,43 @@ namespace NS_SLUA {
         // if it's an UMapProperty
         else if(cls==UMapProperty::StaticClass())
             return LuaMap::push(L,Cast<UMapProperty>(up),obj);
+        // if it's an USetProperty
+        else if(cls==USetProperty::StaticClass())
+            return LuaSet::push(L,Cast<USetProperty>(up),obj);
+		// if struct reference enabled, push struct member as a reference to memory of obj
+		else if (cls==UStructProperty::StaticClass() && LuaState::get(L)->structReferenceEnabled)
+			return pushStructReference(L, Cast<UStructProperty>(up), obj);
 		else
 			return push(L, up, up->ContainerPtrToValuePtr<uint8>(obj), ref);
 	}
 
+	// push struct member of obj as LuaStruct referencing memory of obj, no copy,
+	// it's linked to userdata of obj, and copied when the userdata is collected,
+	// or flagged freed when obj is deleted
+	// UObjectĽṹԱ,
+	int LuaObject::pushStructReference(lua_State* L, UStructProperty* p, UObject* obj) {
+		auto uss = p->Struct;
+		uint8* parms = p->ContainerPtrToValuePtr<uint8>(obj);
+		// wrapped struct is pushed by value
+		if (LuaWrapper::pushValue(L, p, uss, parms))
+			return 1;
+
+		// owner with object handle isn't unlinked when it's deleted, so copy it
+		LuaState* ls = LuaState::get(L);
+		auto ownerud = ls->objectHandleEnabled ? nullptr : ls->objRefs.Find(obj);
+		if (!ownerud || !*ownerud || uss == FLuaBPVar::StaticStruct())
+			return push(L, p, parms, false);
+
+		if (getFromCache(L, parms, "LuaStruct")) return 1;
+		uint32 size = uss->GetStructureSize() ? uss->GetStructureSize() : 1;
+		push(L, new LuaStruct(parms, size, uss, true));
+		cacheObj(L, parms);
+		linkProp(L, *ownerud, lua_touserdata(L, -1));
+		return 1;
+	}
+
 	int LuaObject::push(lua_State* L, LuaStruct* ls) {
+		if (ls) LuaState::get(L)->addStruct(ls);
 		return pushType<LuaStruct*>(L, ls, "LuaStruct", setupInstanceStructMT, gcStruct);
 	}
 
@@ -0,0 +1,178 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaPoolAllocator.h"
+#include <cstring>
+
+#ifdef SLUA_POOL_STANDALONE
+#include <cstdlib>
+#define POOL_MALLOC(size) ::malloc(size)
+#define POOL_REALLOC(ptr, size) ::realloc(ptr, size)
+#define POOL_FREE(ptr) ::free(ptr)
+#else
+#include "CoreMinimal.h"
+#define POOL_MALLOC(size) FMemory::Malloc(size)
+#define POOL_REALLOC(ptr, size) FMemory::Realloc(ptr, size)
+#define POOL_FREE(ptr) FMemory::Free(ptr)
+#endif
+
+namespace NS_SLUA {
+
+	static_assert(sizeof(void*) * 2 <= LuaPoolAllocator::Granularity, "free block must fit in smallest class");
+
+	LuaPoolAllocator::LuaPoolAllocator()
+		: pages(nullptr)
+		, remoteFrees(nullptr)
+	{
+		memset(classes, 0, sizeof(classes));
+		memset(&stats, 0, sizeof(stats));
+		for (int i = 0; i < ClassCount; i++)
+			stats.classes[i].blockSize = (i + 1) * Granularity;
+	}
+
+	LuaPoolAllocator::~LuaPoolAllocator()
+	{
+		while (pages) {
+			void* next = *(void**)pages;
+			POOL_FREE(pages);
+			pages = next;
+		}
+	}
+
+	void* LuaPoolAllocator::alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+	{
+		return ((LuaPoolAllocator*)ud)->realloc(ptr, osize, nsize);
+	}
+
+	void* LuaPoolAllocator::realloc(void* ptr, size_t osize, size_t nsize)
+	{
+		if (remoteFrees.load(std::memory_order_relaxed))
+			collectRemoteFrees();
+
+		if (nsize == 0) {
+			if (ptr) freeBlock(ptr, osize);
+			return nullptr;
+		}
+
+		// osize is type of object when ptr is null
+		if (!ptr) {
+			if (nsize <= MaxSmallSize)
+				return allocSmall(classOf(nsize));
+			stats.largeBytes += nsize;
+			stats.largeAllocs++;
+			return POOL_MALLOC(nsize);
+		}
+
+		if (osize > MaxSmallSize && nsize > MaxSmallSize) {
+			void* p = POOL_REALLOC(ptr, nsize);
+			if (p) {
+				stats.largeBytes += nsize - osize;
+				stats.largeAllocs++;
+			}
+			return p;
+		}
+
+		// size class isn't changed, keep block
+		if (osize <= MaxSmallSize && nsize <= MaxSmallSize && classOf(osize) == classOf(nsize))
+			return ptr;
+
+		void* p = realloc(nullptr, 0, nsize);
+		if (!p) return nullptr;
+		memcpy(p, ptr, osize < nsize ? osize : nsize);
+		freeBlock(ptr, osize);
+		return p;
+	}
+
+	void LuaPoolAllocator::freeRemote(void* ptr, size_t osize)
+	{
+		if (!ptr) return;
+		FreeBlock* block = (FreeBlock*)ptr;
+		block->size = osize;
+		block->next = remoteFrees.load(std::memory_order_relaxed);
+		while (!remoteFrees.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	const LuaPoolAllocator::Stats& LuaPoolAllocator::getStats()
+	{
+		collectRemoteFrees();
+		return stats;
+	}
+
+	void* LuaPoolAllocator::allocSmall(int index)
+	{
+		SizeClass& sc = classes[index];
+		void* p;
+		if (sc.freeList) {
+			p = sc.freeList;
+			sc.freeList = sc.freeList->next;
+		}
+		else {
+			if (sc.bump == sc.bumpEnd && !refill(index))
+				return nullptr;
+			p = sc.bump;
+			sc.bump += stats.classes[index].blockSize;
+		}
+		ClassStats& cs = stats.classes[index];
+		cs.liveBytes += cs.blockSize;
+		if (cs.liveBytes > cs.peakBytes) cs.peakBytes = cs.liveBytes;
+		cs.allocs++;
+		return p;
+	}
+
+	void LuaPoolAllocator::freeBlock(void* ptr, size_t osize)
+	{
+		if (osize <= MaxSmallSize) {
+			freeSmall(ptr, classOf(osize));
+		}
+		else {
+			stats.largeBytes -= osize;
+			POOL_FREE(ptr);
+		}
+	}
+
+	void LuaPoolAllocator::freeSmall(void* ptr, int index)
+	{
+		SizeClass& sc = classes[index];
+		FreeBlock* block = (FreeBlock*)ptr;
+		block->next = sc.freeList;
+		sc.freeList = block;
+		stats.classes[index].liveBytes -= stats.classes[index].blockSize;
+	}
+
+	bool LuaPoolAllocator::refill(int index)
+	{
+		char* page = (char*)POOL_MALLOC(PageSize);
+		if (!page) return false;
+		*(void**)page = pages;
+		pages = page;
+
+		// first block keeps page link
+		size_t blockSize = stats.classes[index].blockSize;
+		SizeClass& sc = classes[index];
+		sc.bump = page + blockSize;
+		sc.bumpEnd = page + (PageSize / blockSize) * blockSize;
+		stats.classes[index].pageBytes += PageSize;
+		stats.pageBytes += PageSize;
+		return true;
+	}
+
+	void LuaPoolAllocator::collectRemoteFrees()
+	{
+		FreeBlock* block = remoteFrees.exchange(nullptr, std::memory_order_acquire);
+		while (block) {
+			FreeBlock* next = block->next;
+			freeBlock(block, block->size);
+			block = next;
+		}
+	}
+}
@@ -0,0 +1,98 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License");
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "lua/lua.hpp"
+
+// only standard types are used here, so it can be built without engine by benchmark
+// with SLUA_POOL_STANDALONE defined, large blocks and pages come from malloc then
+
+namespace NS_SLUA {
+
+	// small-object allocator of a lua state, blocks up to MaxSmallSize bytes are served
+	// from free lists of size classes, carved from pages dedicated to one class,
+	// larger blocks go to engine allocator, pages are released when allocator is destroyed
+	// lua小对象分配器,按大小分级的空闲链表,大块内存交给引擎分配器
+	class LuaPoolAllocator {
+	public:
+		enum {
+			Granularity = 16,
+			MaxSmallSize = 256,
+			ClassCount = MaxSmallSize / Granularity,
+			PageSize = 64 * 1024,
+		};
+
+		struct ClassStats {
+			size_t blockSize;
+			// bytes of blocks in use
+			size_t liveBytes;
+			size_t peakBytes;
+			// bytes of pages owned by the class
+			size_t pageBytes;
+			uint64_t allocs;
+		};
+
+		struct Stats {
+			ClassStats classes[ClassCount];
+			size_t largeBytes;
+			uint64_t largeAllocs;
+			size_t pageBytes;
+		};
+
+		LuaPoolAllocator();
+		~LuaPoolAllocator();
+
+		// same contract as lua_Alloc, must be called on owner thread
+		void* realloc(void* ptr, size_t osize, size_t nsize);
+		// free from any thread, block is queued and reused by owner thread
+		void freeRemote(void* ptr, size_t osize);
+
+		// remote frees are collected first, so it must be called on owner thread
+		const Stats& getStats();
+
+		// lua_Alloc with allocator as ud
+		static void* alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+	private:
+		struct FreeBlock {
+			FreeBlock* next;
+			size_t size;
+		};
+
+		struct SizeClass {
+			FreeBlock* freeList;
+			char* bump;
+			char* bumpEnd;
+		};
+
+		SizeClass classes[ClassCount];
+		Stats stats;
+		// pages are chained by their first pointer
+		void* pages;
+		std::atomic<FreeBlock*> remoteFrees;
+
+		static int classOf(size_t size) { return int((size + Granularity - 1) / Granularity) - 1; }
+
+		void* allocSmall(int index);
+		void freeSmall(void* ptr, int index);
+		void freeBlock(void* ptr, size_t osize);
+		bool refill(int index);
+		void collectRemoteFrees();
+
+		LuaPoolAllocator(const LuaPoolAllocator&) = delete;
+		LuaPoolAllocator& operator=(const LuaPoolAllocator&) = delete;
+	};
+}
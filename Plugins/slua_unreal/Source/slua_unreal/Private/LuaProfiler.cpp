@@ -298,9 +298,7 @@ namespace NS_SLUA {
 		RunState currentRunState = (RunState)selfProfiler.getFromTable<int>("currentRunState");
 		if (currentRunState == RunState::CONNECTED) {
             TArray<LuaMemInfo> memoryInfoList;
-            for(auto& memInfo : NS_SLUA::LuaMemoryProfile::memDetail()) {
-                memoryInfoList.Add(memInfo.Value);
-            }
+            NS_SLUA::LuaMemoryProfile::memDetail(memoryInfoList);
             
             if(checkSocketRead()) memoryGC(L);
             takeMemorySample(NS_SLUA::ProfilerHookEvent::PHE_MEMORY_TICK, memoryInfoList);
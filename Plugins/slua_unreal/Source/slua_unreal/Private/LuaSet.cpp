@@ -0,0 +1,300 @@
+﻿// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#include "LuaSet.h"
+#include "SluaLib.h"
+#include "LuaObject.h"
+#include "Log.h"
+#include "LuaState.h"
+#include "LuaReference.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace NS_SLUA {
+
+	DefTypeName(LuaSet::Enumerator);
+
+	void LuaSet::reg(lua_State* L) {
+		SluaUtil::reg(L, "Set", __ctor);
+	}
+
+	int LuaSet::push(lua_State* L, UProperty* elementProp, const FScriptSet* buf) {
+		auto luaSet = new LuaSet(elementProp, buf);
+		return LuaObject::pushType(L, luaSet, "LuaSet", setupMT, gc);
+	}
+
+	int LuaSet::push(lua_State* L, USetProperty* prop, UObject* obj) {
+		auto scriptSet = prop->ContainerPtrToValuePtr<FScriptSet>(obj);
+		if (LuaObject::getFromCache(L, scriptSet, "LuaSet")) return 1;
+		auto luaSet = new LuaSet(prop, obj);
+		int r = LuaObject::pushType(L, luaSet, "LuaSet", setupMT, gc);
+		if (r) LuaObject::cacheObj(L, luaSet->set);
+		return 1;
+	}
+
+	void LuaSet::clone(FScriptSet* dest, UProperty* elementProp, const FScriptSet* src) {
+		if (!src || src->Num() == 0)
+			return;
+
+		FScriptSetHelper dstHelper = FScriptSetHelper::CreateHelperFormElementProperty(elementProp, dest);
+		FScriptSetHelper srcHelper = FScriptSetHelper::CreateHelperFormElementProperty(elementProp, src);
+		for (auto n = 0; n < srcHelper.GetMaxIndex(); n++) {
+			if (srcHelper.IsValidIndex(n)) {
+				dstHelper.AddElement(srcHelper.GetElementPtr(n));
+			}
+		}
+	}
+
+	LuaSet::LuaSet(UProperty* p, const FScriptSet* buf) :
+		set(new FScriptSet),
+		elementProp(p),
+		prop(nullptr),
+		propObj(nullptr),
+		helper(FScriptSetHelper::CreateHelperFormElementProperty(p, set)),
+		elementKind(getElementKind(p))
+	{
+		if (buf) clone(set, p, buf);
+		// set is cloned data, set a flag to free later
+		shouldFree = true;
+	}
+
+	LuaSet::LuaSet(USetProperty* p, UObject* obj) :
+		set(p->ContainerPtrToValuePtr<FScriptSet>(obj)),
+		elementProp(p->ElementProp),
+		prop(p),
+		propObj(obj),
+		helper(prop, set),
+		shouldFree(false),
+		elementKind(getElementKind(p->ElementProp))
+	{
+	}
+
+	LuaSet::~LuaSet() {
+		if (shouldFree) {
+			clear();
+			ensure(set);
+			SafeDelete(set);
+		}
+		elementProp = nullptr;
+		prop = nullptr;
+		propObj = nullptr;
+	}
+
+	void LuaSet::AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		if (elementProp) Collector.AddReferencedObject(elementProp);
+		if (prop) Collector.AddReferencedObject(prop);
+		if (propObj) Collector.AddReferencedObject(propObj);
+
+		// if empty or owner object had been collected
+		// AddReferencedObject will auto null propObj
+		if ((!shouldFree && !propObj) || num() <= 0) return;
+		bool rehash = false;
+		// for each valid element of set
+		for (int index = helper.GetMaxIndex() - 1; index >= 0; index--) {
+			if (helper.IsValidIndex(index)) {
+				// if element auto null, we remove it
+				// 元素改变后自动变为null
+				if (LuaReference::addRefByProperty(Collector, elementProp, helper.GetElementPtr(index), false)) {
+					helper.RemoveAt(index);
+					rehash = true;
+				}
+			}
+		}
+		// 重新计算hash值
+		if (rehash) helper.Rehash();
+	}
+
+	void LuaSet::clear() {
+		if (!elementProp)
+			return;
+		helper.EmptyElements();
+	}
+
+	int32 LuaSet::num() const {
+		return helper.Num();
+	}
+
+	LuaSet::ElementKind LuaSet::getElementKind(UProperty* p) {
+		auto cls = p->GetClass();
+		if (cls == UIntProperty::StaticClass()) return ElementKind::Int;
+		if (cls == UInt64Property::StaticClass()) return ElementKind::Int64;
+		if (cls == UNameProperty::StaticClass()) return ElementKind::Name;
+		if (cls == UStrProperty::StaticClass()) return ElementKind::Str;
+		if (cls == UObjectProperty::StaticClass()) return ElementKind::Object;
+		return ElementKind::None;
+	}
+
+	// hash and compare element as T directly, same as GetValueTypeHash/Identical of element property
+	template<typename T>
+	int32 LuaSet::findIndexByElement(const T& element) {
+		uint32 hash = GetTypeHash(element);
+		return set->FindIndex(&element, helper.SetLayout,
+			[hash](const void*) { return hash; },
+			[](const void* A, const void* B) { return *(const T*)A == *(const T*)B; }
+		);
+	}
+
+	int32 LuaSet::findIndex(lua_State* L, int p) {
+		switch (elementKind) {
+		case ElementKind::Int:
+			return findIndexByElement(LuaObject::checkValue<int>(L, p));
+		case ElementKind::Int64:
+			return findIndexByElement(LuaObject::checkValue<int64>(L, p));
+		case ElementKind::Object:
+			return findIndexByElement(LuaObject::checkValue<UObject*>(L, p));
+		case ElementKind::Name: {
+			// only find in name table, if name not existed, element not existed too
+			const char* s = luaL_checkstring(L, p);
+			FName name(UTF8_TO_TCHAR(s), FNAME_Find);
+			if (name.IsNone() && *s && FCStringAnsi::Stricmp(s, "None") != 0)
+				return INDEX_NONE;
+			return findIndexByElement(name);
+		}
+		case ElementKind::Str: {
+			// FString hash and compare are case insensitive
+			FUTF8ToTCHAR str(luaL_checkstring(L, p));
+			const TCHAR* element = str.Get();
+			uint32 hash = FCrc::Strihash_DEPRECATED(element);
+			return set->FindIndex(element, helper.SetLayout,
+				[hash](const void*) { return hash; },
+				[](const void* A, const void* B) { return FCString::Stricmp((const TCHAR*)A, **(const FString*)B) == 0; }
+			);
+		}
+		default: {
+			auto checker = LuaObject::getChecker(elementProp);
+			if (!checker) {
+				auto tn = elementProp->GetClass()->GetName();
+				luaL_error(L, "unsupport element type %s to get", TCHAR_TO_UTF8(*tn));
+			}
+			FDefaultConstructedPropertyElement tempElement(elementProp);
+			auto elementPtr = tempElement.GetObjAddress();
+			checker(L, elementProp, (uint8*)elementPtr, p);
+			return helper.FindElementIndexFromHash(elementPtr);
+		}
+		}
+	}
+
+	int LuaSet::__ctor(lua_State* L) {
+		auto type = (EPropertyClass)LuaObject::checkValue<int>(L, 1);
+		auto cls = LuaObject::checkValueOpt<UClass*>(L, 2, nullptr);
+		if (type == EPropertyClass::Object && !cls)
+			luaL_error(L, "UObject element should have 2nd parameter is UClass");
+
+		auto elementProp = PropertyProto::createProperty({ type, cls });
+		return push(L, elementProp, nullptr);
+	}
+
+	int LuaSet::Num(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		return LuaObject::push(L, UD->num());
+	}
+
+	int LuaSet::Contains(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		return LuaObject::push(L, UD->findIndex(L, 2) != INDEX_NONE);
+	}
+
+	int LuaSet::Add(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		auto checker = LuaObject::getChecker(UD->elementProp);
+		if (!checker) {
+			auto tn = UD->elementProp->GetClass()->GetName();
+			luaL_error(L, "unsupport element type %s to add", TCHAR_TO_UTF8(*tn));
+		}
+		FDefaultConstructedPropertyElement tempElement(UD->elementProp);
+		auto elementPtr = tempElement.GetObjAddress();
+		checker(L, UD->elementProp, (uint8*)elementPtr, 2);
+		UD->helper.AddElement(elementPtr);
+		return 0;
+	}
+
+	int LuaSet::Remove(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		int32 index = UD->findIndex(L, 2);
+		if (index != INDEX_NONE) UD->helper.RemoveAt(index);
+		return LuaObject::push(L, index != INDEX_NONE);
+	}
+
+	int LuaSet::Clear(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		UD->clear();
+		return 0;
+	}
+
+	int LuaSet::Pairs(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		auto iter = new LuaSet::Enumerator();
+		// hold LuaSet
+		iter->holder = new LuaVar(L, 1);
+		iter->set = UD;
+		iter->index = 0;
+		iter->num = UD->helper.Num();
+		lua_pushcfunction(L, LuaSet::Enumerable);
+		LuaObject::pushType(L, iter, "LuaSet::Enumerator", nullptr, LuaSet::Enumerator::gc);
+		LuaObject::pushNil(L);
+		return 3;
+	}
+
+	// iterate element, true
+	int LuaSet::Enumerable(lua_State* L) {
+		CheckUD(LuaSet::Enumerator, L, 1);
+		auto set = UD->set;
+		auto& helper = set->helper;
+		do {
+			if (UD->num <= 0) {
+				return 0;
+			} else if (helper.IsValidIndex(UD->index)) {
+				LuaObject::push(L, set->elementProp, helper.GetElementPtr(UD->index));
+				LuaObject::push(L, true);
+				UD->index += 1;
+				UD->num -= 1;
+				return 2;
+			} else {
+				UD->index += 1;
+			}
+		} while (true);
+	}
+
+	int LuaSet::Enumerator::gc(lua_State* L) {
+		CheckUD(LuaSet::Enumerator, L, 1);
+		delete UD;
+		return 0;
+	}
+
+	LuaSet::Enumerator::~Enumerator()
+	{
+		SafeDelete(holder);
+	}
+
+	int LuaSet::gc(lua_State* L) {
+		CheckUD(LuaSet, L, 1);
+		LuaObject::deleteFGCObject(L, UD);
+		return 0;
+	}
+
+	int LuaSet::setupMT(lua_State* L) {
+		LuaObject::setupMTSelfSearch(L);
+
+		RegMetaMethod(L, Pairs);
+		RegMetaMethod(L, Num);
+		RegMetaMethod(L, Contains);
+		RegMetaMethod(L, Add);
+		RegMetaMethod(L, Remove);
+		RegMetaMethod(L, Clear);
+
+		RegMetaMethodByName(L, "__pairs", Pairs);
+
+		return 0;
+	}
+
+}
@@ -0,0 +1,45 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+// luasocket is compiled into the module from External/luasocket like lua sources, see LuaVM.cpp
+// luasocketԴֱӱģ
+
+#include "CoreMinimal.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#pragma push_macro("TEXT")
+#undef TEXT
+#endif
+
+#include "luasocket/auxiliar.cpp"
+#include "luasocket/buffer.cpp"
+#include "luasocket/except.cpp"
+#include "luasocket/inet.cpp"
+#include "luasocket/io.cpp"
+#include "luasocket/luasocket.cpp"
+#include "luasocket/mime.cpp"
+#include "luasocket/options.cpp"
+#include "luasocket/select.cpp"
+#include "luasocket/serial.cpp"
+#include "luasocket/tcp.cpp"
+#include "luasocket/timeout.cpp"
+#include "luasocket/udp.cpp"
+#include "luasocket/unix.cpp"
+#include "luasocket/usocket.cpp"
+#include "luasocket/wsocket.cpp"
+
+#if PLATFORM_WINDOWS
+#pragma pop_macro("TEXT")
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
@@ -26,8 +26,10 @@
 #include "LuaWrapper.h"
 #include "LuaArray.h"
 #include "LuaMap.h"
+#include "LuaSet.h"
 #include "LuaSocketWrap.h"
 #include "LuaMemoryProfile.h"
+#include "LuaPoolAllocator.h"
 #include "HAL/RunnableThread.h"
 #include "GameDelegates.h"
 #include "LatentDelegate.h"
@@ -231,6 +233,13 @@ namespace NS_SLUA {
 		, cacheObjRef(LUA_NOREF)
 		, stackCount(0)
 		, si(0)
+		, classMetatableEnabled(false)
+		, structReferenceEnabled(false)
+		, objectHandleEnabled(false)
+		, poolAllocatorEnabled(false)
+		, poolAllocator(nullptr)
+		, gcStepBudget(0.002)
+		, memberNameRef(LUA_NOREF)
 		, deadLoopCheck(nullptr)
     {
         if(name) stateName=UTF8_TO_TCHAR(name);
@@ -288,13 +297,15 @@ namespace NS_SLUA {
 		{
 			// NS_SLUA::LuaProfiler w2("TickFunc")
 			PROFILER_WATCHER_X(w2,"TickFunc");
-			stateTickFunc.call(dtime);
+			stateTickFunc.callTyped<void>(dtime);
 		}
 
 		// try lua gc
 		// һGC
 		PROFILER_WATCHER_X(w3, "LuaGC");
-		if (!enableMultiThreadGC) lua_gc(L, LUA_GCSTEP, 128);
+		if (!enableMultiThreadGC) gcScheduler.tick(L, dtime);
+		// garbage swept by full gc of script or by emergency gc
+		dispatchGarbage();
     }
 
     void LuaState::close() {
@@ -309,6 +320,8 @@ namespace NS_SLUA {
 		cleanupThreads();
         
         if(L) {
+			// pending garbage must be freed before lua_close
+			waitGarbage();
 
         	/*
         	 * void lua_close (lua_State *L)
@@ -321,7 +334,8 @@ namespace NS_SLUA {
         	 */
         	
             lua_close(L);
-			GUObjectArray.RemoveUObjectDeleteListener(this);
+			if (!objectHandleEnabled)
+				GUObjectArray.RemoveUObjectDeleteListener(this);
 			FCoreUObjectDelegates::GetPostGarbageCollect().Remove(pgcHandler);
 			FWorldDelegates::OnWorldCleanup.Remove(wcHandler);
             stateMapFromIndex.Remove(si);
@@ -330,7 +344,18 @@ namespace NS_SLUA {
 
 		freeDeferObject();
 		objRefs.Empty();
+		refObjects.Empty();
+		refUserdatas.Empty();
+		refKeys.Empty();
+		refIndices.Empty();
+		objCache.clear();
+		structs.Empty();
+		LuaStruct::releaseBufferPool();
+		classMetatables.Empty();
+		callPlans.Empty();
 		SafeDelete(deadLoopCheck);
+		// all blocks of pool are freed by lua_close
+		SafeDelete(poolAllocator);
     }
 
 
@@ -345,11 +370,15 @@ namespace NS_SLUA {
             mainState = this;
 
 		enableMultiThreadGC = gcFlag;
+		gcScheduler.reset();
+		gcScheduler.setConfig(LuaGCScheduler::getStateConfig(stateName));
 		// GCص
 		pgcHandler = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &LuaState::onEngineGC);
 		wcHandler = FWorldDelegates::OnWorldCleanup.AddRaw(this, &LuaState::onWorldCleanup);
 		// ̳FUObjectDeleteListener,ɾʱNotifyUObjectDeleted
-		GUObjectArray.AddUObjectDeleteListener(this);
+		// deleted UObject is detected by its handle if object handle is enabled
+		if (!objectHandleEnabled)
+			GUObjectArray.AddUObjectDeleteListener(this);
 
 		latentDelegate = NewObject<ULatentDelegate>((UObject*)GetTransientPackage(), ULatentDelegate::StaticClass());
 		latentDelegate->bindLuaState(this);
@@ -361,7 +390,15 @@ namespace NS_SLUA {
 		// 
 		propLinks.Empty();
 		classMap.clear();
+		classMetatables.Empty();
+		callPlans.Empty();
 		objRefs.Empty();
+		refObjects.Empty();
+		refUserdatas.Empty();
+		refKeys.Empty();
+		refIndices.Empty();
+		objCache.clear();
+		structs.Empty();
 
 #if WITH_EDITOR
 		// used for debug
@@ -376,6 +413,8 @@ namespace NS_SLUA {
 		// ޷̻߳״̬ڴޣ򷵻 NULL
 		//  f һ Lua ͨ״̬еڴ
 		// ڶ ud ָ뽫ÿε÷ʱת롣
+		if (poolAllocatorEnabled)
+			poolAllocator = new LuaPoolAllocator();
         L = lua_newstate(LuaMemoryProfile::alloc,this);
 		// һµ panic ֮ǰõǸ
 		// panic ԴϢķʽ
@@ -440,6 +479,10 @@ namespace NS_SLUA {
 		
         cacheObjRef = luaL_ref(L,LUA_REGISTRYINDEX);
 
+		// init member name table
+		lua_newtable(L);
+		memberNameRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
 		/*
 		 * int lua_gettop (lua_State *L)
 		 * ջԪص
@@ -592,6 +635,7 @@ namespace NS_SLUA {
         LuaClass::reg(L);
         LuaArray::reg(L);
         LuaMap::reg(L);
+        LuaSet::reg(L);
 #ifdef ENABLE_PROFILER
 		LuaProfiler::init(L);
 #endif
@@ -614,8 +658,11 @@ namespace NS_SLUA {
 		 * LUA_GCISRUNNING: ռǷУûֹͣ
 		 */
 
-		// disable gc in main thread
-		if (enableMultiThreadGC) lua_gc(L, LUA_GCSTOP, 0);
+		// disable gc in main thread, swept objects are freed on background task
+		if (enableMultiThreadGC) {
+			lua_gc(L, LUA_GCSTOP, 0);
+			lua_gc(L, LUA_GCDEFERFREE, 1);
+		}
 
         lua_settop(L,0);
 
@@ -662,12 +709,22 @@ namespace NS_SLUA {
 	void LuaState::releaseLink(void* prop) {
 		auto propud = reinterpret_cast<GenericUserData*>(prop);
 		// LuaάGC
-		if (propud->flag & UD_AUTOGC) {
+		// inline value owns its memory as well
+		if (propud->flag & (UD_AUTOGC | UD_INLINE)) {
 			auto propListPtr = propLinks.Find(propud);
-			if (propListPtr) 
+			if (propListPtr) {
 				for (auto& cprop : *propListPtr)
 					// flagλΪѾͷ
 					reinterpret_cast<GenericUserData*>(cprop)->flag |= UD_HADFREE;
+				// address of ud will be reused by lua
+				propLinks.Remove(propud);
+			}
+			// struct reference is owned by lua too, remove it from its parent
+			if (propud->parent) {
+				auto parentListPtr = propLinks.Find(propud->parent);
+				if (parentListPtr)
+					parentListPtr->Remove(propud);
+			}
 		} else {
 			propud->flag |= UD_HADFREE;
 			auto propListPtr = propLinks.Find(propud->parent);
@@ -676,6 +733,122 @@ namespace NS_SLUA {
 		}
 	}
 
+	void LuaState::releaseObjectLink(GenericUserData* ud, bool detach) {
+		auto propListPtr = propLinks.Find(ud);
+		if (!propListPtr) return;
+		for (auto& prop : *propListPtr) {
+			auto propud = reinterpret_cast<GenericUserData*>(prop);
+			propud->parent = nullptr;
+			if (propud->flag & UD_USTRUCT) {
+				LuaStruct* ls = reinterpret_cast<UserData<LuaStruct*>*>(propud)->ud;
+				LuaObject::removeFromCache(L, ls->buf);
+				// copy struct while memory of object is still valid
+				if (detach) {
+					ls->detach();
+					continue;
+				}
+			}
+			propud->flag |= UD_HADFREE;
+		}
+		propLinks.Remove(ud);
+	}
+
+	uint32 LuaState::ObjectCache::homeOf(void* key) const {
+		// fibonacci hashing, take high bits of the product which are mixed from all bits of pointer,
+		// low bits of the product only depend on low bits of pointer which are mostly aligned
+		// ȡ˻λΪλ
+		return (uint32)(((uint64)(UPTRINT)key * 0x9E3779B97F4A7C15ull) >> shift);
+	}
+
+	int32 LuaState::ObjectCache::indexOf(void* key) const {
+		if (count == 0) return INDEX_NONE;
+		uint32 mask = entries.Num() - 1;
+		for (uint32 i = homeOf(key); ; i = (i + 1) & mask) {
+			const Entry& e = entries[i];
+			if (e.key == key) return i;
+			if (!e.key) return INDEX_NONE;
+		}
+	}
+
+	int32 LuaState::ObjectCache::find(void* key) const {
+		int32 index = indexOf(key);
+		return index == INDEX_NONE ? 0 : entries[index].slot;
+	}
+
+	int32 LuaState::ObjectCache::add(void* key) {
+		// keep load factor under 3/4
+		if ((count + 1) * 4 > entries.Num() * 3)
+			grow();
+		uint32 mask = entries.Num() - 1;
+		uint32 i = homeOf(key);
+		for (; entries[i].key; i = (i + 1) & mask) {
+			if (entries[i].key == key)
+				return entries[i].slot;
+		}
+		entries[i].key = key;
+		entries[i].slot = freeSlots.Num() > 0 ? freeSlots.Pop(false) : ++maxSlot;
+		count++;
+		return entries[i].slot;
+	}
+
+	int32 LuaState::ObjectCache::remove(void* key) {
+		int32 index = indexOf(key);
+		if (index == INDEX_NONE) return 0;
+		int32 slot = entries[index].slot;
+		// backward shift following entries, no tombstone left
+		uint32 mask = entries.Num() - 1;
+		uint32 i = index;
+		for (uint32 j = (i + 1) & mask; entries[j].key; j = (j + 1) & mask) {
+			uint32 home = homeOf(entries[j].key);
+			if (((j - home) & mask) >= ((j - i) & mask)) {
+				entries[i] = entries[j];
+				i = j;
+			}
+		}
+		entries[i].key = nullptr;
+		freeSlots.Add(slot);
+		count--;
+		return slot;
+	}
+
+	void LuaState::ObjectCache::grow() {
+		TArray<Entry> old = MoveTemp(entries);
+		int32 size = FMath::Max(old.Num() * 2, 256);
+		entries.SetNumZeroed(size);
+		shift = 64 - FMath::FloorLog2(size);
+		uint32 mask = size - 1;
+		for (auto& e : old) {
+			if (!e.key) continue;
+			uint32 i = homeOf(e.key);
+			while (entries[i].key) i = (i + 1) & mask;
+			entries[i] = e;
+		}
+	}
+
+	void LuaState::ObjectCache::clear() {
+		entries.Empty();
+		freeSlots.Empty();
+		shift = 64;
+		count = 0;
+		maxSlot = 0;
+		lookupCount = 0;
+		hitCount = 0;
+	}
+
+	void LuaState::addStruct(LuaStruct* ls) {
+		ls->index = structs.Add(ls);
+	}
+
+	void LuaState::removeStruct(LuaStruct* ls) {
+		int32 index = ls->index;
+		if (!structs.IsValidIndex(index) || structs[index] != ls)
+			return;
+		structs.RemoveAtSwap(index, 1, false);
+		if (index < structs.Num())
+			structs[index]->index = index;
+		ls->index = INDEX_NONE;
+	}
+
 	void LuaState::releaseAllLink() {
 		for (auto& pair : propLinks) 
 			for (auto& prop : pair.Value) 
@@ -688,6 +861,12 @@ namespace NS_SLUA {
 	void LuaState::onEngineGC()
 	{
 		PROFILER_WATCHER(w1);
+		// lua gc is stopped in multi-thread gc mode, step it out of reference collecting
+		if (enableMultiThreadGC) {
+			PROFILER_WATCHER_X(w2, "LuaGC");
+			stepGC(gcStepBudget);
+		}
+
 		// find freed uclass
 		for (ClassCache::CacheFuncMap::TIterator it(classMap.cacheFuncMap); it; ++it)
 			if (!it.Key().IsValid())
@@ -696,6 +875,26 @@ namespace NS_SLUA {
 		for (ClassCache::CachePropMap::TIterator it(classMap.cachePropMap); it; ++it)
 			if (!it.Key().IsValid())
 				it.RemoveCurrent();		
+
+		int32 memberCount = classMap.cacheMemberMap.Num();
+		for (ClassCache::CacheMemberMap::TIterator it(classMap.cacheMemberMap); it; ++it)
+			if (!it.Value().uclass.IsValid())
+				it.RemoveCurrent();
+		if (memberCount != classMap.cacheMemberMap.Num())
+			pruneMemberNames();
+
+		// release metatable of freed uclass, include hot reloaded class
+		for (auto it = classMetatables.CreateIterator(); it; ++it) {
+			if (!it.Key().IsValid()) {
+				luaL_unref(L, LUA_REGISTRYINDEX, it.Value());
+				it.RemoveCurrent();
+			}
+		}
+
+		// remove call plan of freed function, its address may be reused
+		for (auto it = callPlans.CreateIterator(); it; ++it)
+			if (!it.Value()->func.IsValid())
+				it.RemoveCurrent();
 		
 		freeDeferObject();
 
@@ -781,7 +980,7 @@ namespace NS_SLUA {
 	}
 
 	// ͷŵ
-	void LuaState::unlinkUObject(const UObject * Object)
+	void LuaState::unlinkUObject(const UObject * Object, bool detach)
 	{
 		// find Object from objRefs, maybe nothing
 		auto udptr = objRefs.Find(Object);
@@ -795,6 +994,7 @@ namespace NS_SLUA {
 		// remove should put here avoid ud is invalid
 		// remove ref, Object must be an UObject in slua
 		objRefs.Remove(const_cast<UObject*>(Object));
+		removeReference(Object);
 
 		// maybe ud is nullptr or had been freed
 		if (!ud) {
@@ -812,26 +1012,92 @@ namespace NS_SLUA {
 		// remove cache
 		ensure(ud->ud == Object);
 		LuaObject::removeFromCache(L, ud->ud);
+		releaseObjectLink(ud, detach);
 	}
 
 	// ѳеĶռ
 	void LuaState::AddReferencedObjects(FReferenceCollector & Collector)
 	{
-		for (UObjectRefMap::TIterator it(objRefs); it; ++it)
-		{
-			UObject* item = it.Key();
-			GenericUserData* userData = it.Value();
-			if (userData && !(userData->flag & UD_REFERENCE))
-			{
-				continue;
+		// referenced object may be destroyed explicitly, drop it before collector touches it
+		if (objectHandleEnabled) {
+			for (int32 i = refUserdatas.Num() - 1; i >= 0; i--) {
+				GenericUserData* userData = refUserdatas[i];
+				// object without userdata is owned by slua, such as delegate
+				if (!userData || LuaObject::isObjectHandleValid(userData))
+					continue;
+				userData->flag |= UD_HADFREE;
+				UObject* obj = (UObject*)userData->ud;
+				objRefs.Remove(obj);
+				removeReference(obj);
 			}
-			Collector.AddReferencedObject(item);
 		}
-		// do more gc step in collecting thread
-		// lua_gc can be call async in bg thread in some isolate position
-		// but this position equivalent to main thread
-		// we just try and find some proper async position
-		if (enableMultiThreadGC && L) lua_gc(L, LUA_GCSTEP, 128);
+		// objects referenced by lua are kept in dense array, collector may null pending kill object
+		Collector.AddReferencedObjects(refObjects);
+		// reference objects in all structs held by lua
+		for (auto ls : structs)
+			ls->AddReferencedObjects(Collector);
+		// lua gc step is run in onEngineGC, keep reference collecting short
+	}
+
+	void LuaState::addReference(UObject* obj, GenericUserData* ud)
+	{
+		removeReference(obj);
+		refIndices.Add(obj, refObjects.Add(obj));
+		refUserdatas.Add(ud);
+		refKeys.Add(obj);
+	}
+
+	void LuaState::removeReference(const UObject* obj)
+	{
+		int32 index;
+		if (!refIndices.RemoveAndCopyValue(obj, index))
+			return;
+		int32 last = refObjects.Num() - 1;
+		if (index != last) {
+			refObjects[index] = refObjects[last];
+			refUserdatas[index] = refUserdatas[last];
+			// object in array may be nulled by collector and userdata may be nullptr, use original key
+			refKeys[index] = refKeys[last];
+			refIndices[refKeys[index]] = index;
+		}
+		refObjects.Pop(false);
+		refUserdatas.Pop(false);
+		refKeys.Pop(false);
+	}
+
+	void LuaState::stepGC(double budget)
+	{
+		if (!L) return;
+		double end = FPlatformTime::Seconds() + budget;
+		do {
+			// return 1 if a cycle is finished
+			if (lua_gc(L, LUA_GCSTEP, 0))
+				break;
+		} while (FPlatformTime::Seconds() < end);
+		dispatchGarbage();
+	}
+
+	void LuaState::dispatchGarbage()
+	{
+		if (!L) return;
+		void* garbage = lua_detachgarbage(L);
+		if (!garbage) return;
+
+		for (int32 i = garbageTasks.Num() - 1; i >= 0; i--)
+			if (garbageTasks[i]->IsComplete())
+				garbageTasks.RemoveAtSwap(i, 1, false);
+
+		// only allocator is touched by task, finalizers were called by lua on game thread
+		garbageTasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([this, garbage]() {
+			lua_freegarbage(LuaMemoryProfile::freeAsync, this, garbage);
+		}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask));
+	}
+
+	void LuaState::waitGarbage()
+	{
+		if (garbageTasks.Num() > 0)
+			FTaskGraphInterface::Get().WaitUntilTasksComplete(garbageTasks);
+		garbageTasks.Empty();
 	}
 #if (ENGINE_MINOR_VERSION>=23) && (ENGINE_MAJOR_VERSION>=4)
 	void LuaState::OnUObjectArrayShutdown() {
@@ -1113,7 +1379,7 @@ namespace NS_SLUA {
 
 	void LuaState::setTickFunction(LuaVar func)
 	{
-		stateTickFunc = func;
+		stateTickFunc = MoveTemp(func);
 	}
 
 	void LuaState::addRef(UObject* obj, void* ud, bool ref)
@@ -1122,17 +1388,38 @@ namespace NS_SLUA {
 		auto* udptr = objRefs.Find(obj);
 		// if any obj find in objRefs, it should be flag freed and removed
 		if (udptr) {
-			(*udptr)->flag |= UD_HADFREE;
+			if (*udptr) (*udptr)->flag |= UD_HADFREE;
 			objRefs.Remove(obj);
+			removeReference(obj);
 		}
 
 		GenericUserData* userData = (GenericUserData*)ud;
-		if (ref && userData) {
-			userData->flag |= UD_REFERENCE;
+		// object without userdata is referenced too, such as delegate held by lua function
+		if (ref) {
+			if (userData) userData->flag |= UD_REFERENCE;
+			addReference(obj, userData);
+		}
+		// object handle needn't delete notification, only hold referenced object
+		else if (objectHandleEnabled) {
+			return;
 		}
 		objRefs.Add(obj,userData);
 	}
 
+	void LuaState::releaseObjectHandle(GenericUserData* ud)
+	{
+		UObject* obj = (UObject*)ud->ud;
+		// key may be a new object of same address
+		auto udptr = objRefs.Find(obj);
+		if (udptr && *udptr == ud) {
+			objRefs.Remove(obj);
+			removeReference(obj);
+		}
+		bool alive = !(ud->flag & UD_HADFREE) && LuaObject::isObjectHandleValid(ud);
+		releaseObjectLink(ud, alive);
+		ud->flag |= UD_HADFREE;
+	}
+
 	FDeadLoopCheck::FDeadLoopCheck()
 		: timeoutEvent(nullptr)
 		, timeoutCounter(0)
@@ -1264,6 +1551,22 @@ namespace NS_SLUA {
 		return nullptr;
 	}
 
+	const CacheMember* LuaState::ClassCache::findMember(UClass* uclass, const char* name)
+	{
+		MemberKey key = { uclass, name };
+		auto item = cacheMemberMap.Find(key);
+		if (!item) return nullptr;
+		// key holds raw class pointer, entry of a freed class isn't pruned until onEngineGC,
+		// check weak pointer so a new class allocated at same address never hits it,
+		// extension entries have no field of their own to catch it
+		// ͷŵδʱ,ܸͬһַ,ָУ
+		if (!item->uclass.IsValid()) {
+			cacheMemberMap.Remove(key);
+			return nullptr;
+		}
+		return &item->member;
+	}
+
 	void LuaState::ClassCache::cacheFunc(UClass* uclass, const char* fname, UFunction* func)
 	{
 		auto& item = cacheFuncMap.FindOrAdd(uclass);
@@ -1275,4 +1578,26 @@ namespace NS_SLUA {
 		auto& item = cachePropMap.FindOrAdd(uclass);
 		item.Add(UTF8_TO_TCHAR(pname), prop);
 	}
+
+	void LuaState::pruneMemberNames()
+	{
+		// rebuild anchor table from names still cached, names of freed class can be collected
+		// ؽԱ,ͷжĳԱ
+		AutoStack as(L);
+		lua_newtable(L);
+		for (auto& it : classMap.cacheMemberMap) {
+			// name is anchored by old table, so same interned string is pushed
+			lua_pushstring(L, it.Key.name);
+			lua_pushboolean(L, true);
+			lua_rawset(L, -3);
+		}
+		lua_rawseti(L, LUA_REGISTRYINDEX, memberNameRef);
+	}
+
+	void LuaState::ClassCache::cacheMember(UClass* uclass, const char* name, const CacheMember& member)
+	{
+		MemberKey key = { uclass, name };
+		MemberItem item = { uclass, member };
+		cacheMemberMap.Add(key, item);
+	}
 }
@@ -27,6 +27,9 @@
 namespace NS_SLUA {
 
 	const int INVALID_INDEX = -1;
+	// same as LUAI_MAXSHORTLEN, longer strings are not interned by lua
+	// LUAI_MAXSHORTLENһ,ַluaڲ
+	const size_t MAX_SHORT_STRLEN = 40;
 	// ͵ĳʼ
     LuaVar::LuaVar()
         :stateIndex(INVALID_INDEX)
@@ -204,12 +207,11 @@ namespace NS_SLUA {
         	
             set(lua_tonumber(l,p));
             break;
-		case LV_STRING: {
-			size_t len;
-			const char* buf = lua_tolstring(l, p, &len);
-			set(buf,len);
+		case LV_STRING:
+			alloc(1);
+			vars[0].s = StrBuf::create(l, p);
+			vars[0].luatype = type;
 			break;
-		}
         case LV_BOOL:
 
         	/*
@@ -241,12 +243,10 @@ namespace NS_SLUA {
         case LV_USERDATA:
             alloc(1);
         	// ѹջĿΪ
-        	// RefRef캯лluaL_ref
-        	// ֵ
+        	// luaL_refֵ
         	// ͬʱluaL_refᵯջ
         	// push֮ûpop
-            lua_pushvalue(l,p);
-            vars[0].ref = new RefRef(l);
+            vars[0].ref = SharedRef::create(l,p);
             vars[0].luatype=type;
             break;
         case LV_TUPLE:
@@ -290,27 +290,21 @@ namespace NS_SLUA {
                     }
                 }
                 break;
-			case LUA_TSTRING: {
+			case LUA_TSTRING:
 				vars[i].luatype = LV_STRING;
-				size_t len;
-				const char* buf = lua_tolstring(l, p, &len);
-				vars[i].s = new RefStr(buf,len);
+				vars[i].s = StrBuf::create(l, p);
 				break;
-			}
             case LUA_TFUNCTION:
                 vars[i].luatype = LV_FUNCTION;
-                lua_pushvalue(l,p);
-                vars[i].ref = new RefRef(l);
+                vars[i].ref = SharedRef::create(l,p);
                 break;
             case LUA_TTABLE:
                 vars[i].luatype = LV_TABLE;
-                lua_pushvalue(l,p);
-                vars[i].ref = new RefRef(l);
+                vars[i].ref = SharedRef::create(l,p);
                 break;
 			case LUA_TUSERDATA:
 				vars[i].luatype = LV_USERDATA;
-				lua_pushvalue(l, p);
-				vars[i].ref = new RefRef(l);
+				vars[i].ref = SharedRef::create(l, p);
 				break;
 			case LUA_TLIGHTUSERDATA:
 				vars[i].luatype = LV_LIGHTUD;
@@ -329,46 +323,78 @@ namespace NS_SLUA {
         free();
     }
 
-    LuaVar::RefRef::RefRef(lua_State* l) 
-        :LuaVar::Ref() 
-    {
-    	// ,ᵯջ
-        ref=luaL_ref(l,LUA_REGISTRYINDEX);
-        stateIndex = LuaState::get(l)->stateIndex();
-    }
-
-    LuaVar::RefRef::~RefRef() {
-        if(LuaState::isValid(stateIndex)) {
-            auto state = LuaState::get(stateIndex);
-        	/*
-        	 * void luaL_unref (lua_State *L, int t, int ref)
-        	 * ͷ t  ref ö
-        	 * ĿӱƳõĶɱռ
-        	 *  ref Ҳٴʹ
-        	 *  ref Ϊ LUA_NOREF  LUA_REFNIL luaL_unref ʲôҲ
-        	 */
-
-            luaL_unref(state->getLuaState(),LUA_REGISTRYINDEX,ref);
+    LuaVar::StrBuf* LuaVar::StrBuf::create(const char* s, size_t len) {
+        if (len == 0) len = strlen(s);
+        // alloc extra space for '\0'
+        // Ϊ'\0' ࿪һռ
+        StrBuf* sb = (StrBuf*) FMemory::Malloc(sizeof(StrBuf)+len+1);
+        sb->refCount = 1;
+        sb->ref = LUA_NOREF;
+        sb->length = len;
+        FMemory::Memcpy(sb->buf(), s, len);
+        sb->buf()[len] = 0;
+        return sb;
+    }
+
+    LuaVar::StrBuf* LuaVar::StrBuf::create(lua_State* l, int p) {
+        // number is converted in place, so reference is a string
+        size_t len;
+        const char* s = lua_tolstring(l, p, &len);
+        StrBuf* sb = create(s, len);
+        // long string keeps a registry reference so pushing it does not create a new lua string
+        // ַ,ѹջʱ¼ϣ
+        if(len > MAX_SHORT_STRLEN) {
+            lua_pushvalue(l, p);
+            sb->ref = luaL_ref(l, LUA_REGISTRYINDEX);
+        }
+        return sb;
+    }
+
+    LuaVar::SharedRef* LuaVar::SharedRef::create(lua_State* l, int p) {
+        SharedRef* r = (SharedRef*) FMemory::Malloc(sizeof(SharedRef));
+        r->refCount = 1;
+        lua_pushvalue(l, p);
+        r->ref = luaL_ref(l, LUA_REGISTRYINDEX);
+        return r;
+    }
+
+    void LuaVar::release(SharedRef* r) const {
+        if(--r->refCount > 0)
+            return;
+        /*
+         * void luaL_unref (lua_State *L, int t, int ref)
+         * ͷ t  ref ö
+         * ĿӱƳõĶɱռ
+         *  ref Ҳٴʹ
+         *  ref Ϊ LUA_NOREF  LUA_REFNIL luaL_unref ʲôҲ
+         */
+        // references are dropped only if state is still open
+        if(r->ref != LUA_NOREF) {
+            auto L = getState();
+            if(L) luaL_unref(L, LUA_REGISTRYINDEX, r->ref);
         }
+        FMemory::Free(r);
     }
 
 	// ͷ
     void LuaVar::free() {
         for(size_t n=0;n<numOfVar;n++) {
-            if( (vars[n].luatype==LV_FUNCTION || vars[n].luatype==LV_TABLE || vars[n].luatype == LV_USERDATA)
-                && vars[n].ref->isValid() )
-                vars[n].ref->release();
+            if(hasRef(vars[n]))
+                release(vars[n].ref);
             else if(vars[n].luatype==LV_STRING)
-                vars[n].s->release();
+                release(vars[n].s);
         }
         numOfVar = 0;
-        delete[] vars;
+        if(vars!=&inlineVar)
+            delete[] vars;
         vars = nullptr;
     }
 
     void LuaVar::alloc(int n) {
         if(n>0) {
-            vars = new lua_var[n];
+            // single value is stored in LuaVar itself, only tuple allocates
+            // ֵڴ
+            vars = n==1 ? &inlineVar : new lua_var[n];
             numOfVar = n;
         }
     }
@@ -487,13 +513,14 @@ namespace NS_SLUA {
     const char* LuaVar::asString(size_t* outlen) const {
         ensure(numOfVar==1 && vars[0].luatype==LV_STRING);
 		if(outlen) *outlen = vars[0].s->length;
-        return vars[0].s->buf;
+        return vars[0].s->buf();
     }
 
 	LuaLString LuaVar::asLString() const
 	{
-		ensure(numOfVar == 1 && vars[0].luatype == LV_STRING);
-		return { vars[0].s->buf,vars[0].s->length };
+		LuaLString lstr;
+		lstr.buf = asString(&lstr.len);
+		return lstr;
 	}
 
     bool LuaVar::asBool() const {
@@ -550,7 +577,7 @@ namespace NS_SLUA {
     void LuaVar::set(const char* v,size_t len) {
         free();
         alloc(1);
-        vars[0].s = new RefStr(v,len);
+        vars[0].s = StrBuf::create(v,len);
         vars[0].luatype = LV_STRING;
     }
 
@@ -566,7 +593,7 @@ namespace NS_SLUA {
         vars[0].luatype = LV_BOOL;
     }
 
-    void LuaVar::pushVar(lua_State* l,const lua_var& ov) const {
+    void LuaVar::pushVar(lua_State* l,const lua_var& ov,bool owner) const {
         switch(ov.luatype) {
         case LV_INT:
             lua_pushinteger(l,ov.i);
@@ -578,12 +605,22 @@ namespace NS_SLUA {
             lua_pushboolean(l,ov.b);
             break;
         case LV_STRING:
-            lua_pushlstring(l,ov.s->buf,ov.s->length);
+            if(owner && ov.s->ref!=LUA_NOREF)
+                lua_geti(l,LUA_REGISTRYINDEX,ov.s->ref);
+            else
+                lua_pushlstring(l,ov.s->buf(),ov.s->length);
             break;
         case LV_FUNCTION:
         case LV_TABLE:
         case LV_USERDATA:
-            ov.ref->push(l);
+            // registry reference is only meaningful in the state that created it
+            // ֻڴstateЧ
+            if(owner)
+                lua_geti(l,LUA_REGISTRYINDEX,ov.ref->ref);
+            else {
+                Log::Error("Can't push lua reference to another lua state");
+                lua_pushnil(l);
+            }
             break;
         case LV_LIGHTUD:
             lua_pushlightuserdata(l,ov.ptr);
@@ -595,7 +632,12 @@ namespace NS_SLUA {
     }
 
     int LuaVar::push(lua_State* l) const {
+        bool owner = true;
         if(l==nullptr) l=getState();
+        else {
+            auto ls = LuaState::get(l);
+            owner = ls && ls->stateIndex()==stateIndex;
+        }
         if(l==nullptr) return 0;
 
         if(vars==nullptr || numOfVar==0) {
@@ -605,12 +647,12 @@ namespace NS_SLUA {
         
         if(numOfVar==1) {
             const lua_var& ov = vars[0];
-            pushVar(l,ov);
+            pushVar(l,ov,owner);
             return 1;
         }
         for(size_t n=0;n<numOfVar;n++) {
             const lua_var& ov = vars[n];
-            pushVar(l,ov);
+            pushVar(l,ov,owner);
         }
         return numOfVar;
     }
@@ -651,7 +693,7 @@ namespace NS_SLUA {
         if(numOfVar==1 && vars[0].luatype==LV_USERDATA) {
             auto L = getState();
             push(L);
-            void* p = luaL_testudata(L, -1, t);
+            void* p = LuaObject::testUserdata(L, -1, t);
             lua_pop(L,1);
             return p!=nullptr;
         }
@@ -698,7 +740,7 @@ namespace NS_SLUA {
         lua_insert(L,top);
     	// Ѻָѹջ
     	// ջ=>ջ error n 
-        vars[0].ref->push(L);
+        lua_geti(L,LUA_REGISTRYINDEX,vars[0].ref->ref);
 
 		{
         	/*
@@ -773,13 +815,6 @@ namespace NS_SLUA {
         return lua_gettop(L)-top+1;
     }
 
-    int LuaVar::pushArgByParms(UProperty* prop,uint8* parms) {
-        auto L = getState();
-        if (LuaObject::push(L,prop,parms,false))
-            return prop->ElementSize;
-        return 0;
-    }
-
     bool LuaVar::callByUFunction(UFunction* func,uint8* parms, LuaVar* pSelf, FOutParmRec* OutParms) {
         
         if(!func) return false;
@@ -811,6 +846,12 @@ namespace NS_SLUA {
 			pSelf->push();
 			n++;
 		}
+        n += pushParms(getState(),func,parms);
+        return callWithParms(func,parms,n,OutParms);
+    }
+
+    int LuaVar::pushParms(lua_State* L,UFunction* func,uint8* parms) {
+        int n=0;
         // push arguments to lua state
     	// ӵluastate
         for(TFieldIterator<UProperty> it(func);it && (it->PropertyFlags&CPF_Parm);++it) {
@@ -820,12 +861,16 @@ namespace NS_SLUA {
             if((propflag&CPF_ReturnParm) || IsRealOutParam(propflag))
                 continue;
 
-            pushArgByParms(prop,parms+prop->GetOffset_ForInternal());
+            LuaObject::push(L,prop,parms+prop->GetOffset_ForInternal(),false);
             n++;
         }
-        
+        return n;
+    }
+
+    bool LuaVar::callWithParms(UFunction* func,uint8* parms,int argn,FOutParmRec* OutParms) {
+        const bool bHasReturnParam = func->ReturnValueOffset != MAX_uint16;
 		auto L = getState();
-        int retCount = docall(n);
+        int retCount = docall(argn);
 		int remain = retCount;
         // if lua return value
         // we only handle first lua return value
@@ -890,15 +935,14 @@ namespace NS_SLUA {
             break;
         case LV_STRING:
             tv.s = ov.s;
-        	// ü+1
-            tv.s->addRef();
+            tv.s->refCount++;
             break;
         case LV_FUNCTION:
         case LV_TABLE:
         case LV_USERDATA:
+        	// ü
             tv.ref = ov.ref;
-        	// ü+1
-            tv.ref->addRef();
+            tv.ref->refCount++;
             break;
         case LV_LIGHTUD:
             tv.ptr = ov.ptr;
@@ -913,9 +957,8 @@ namespace NS_SLUA {
 
     void LuaVar::clone(const LuaVar& other) {
         stateIndex = other.stateIndex;
-        numOfVar = other.numOfVar;
-        if(numOfVar>0 && other.vars) {
-            vars = new lua_var[numOfVar];
+        if(other.numOfVar>0 && other.vars) {
+            alloc(other.numOfVar);
             for(size_t n=0;n<numOfVar;n++) {
                 varClone( vars[n], other.vars[n] );
             }
@@ -925,7 +968,13 @@ namespace NS_SLUA {
     void LuaVar::move(LuaVar&& other) {
         stateIndex = other.stateIndex;
         numOfVar = other.numOfVar;
-        vars = other.vars;
+        // inline value is copied, its ref is owned by this now
+        if(other.vars==&other.inlineVar) {
+            inlineVar = other.inlineVar;
+            vars = &inlineVar;
+        }
+        else
+            vars = other.vars;
 
     	// Ĭmoveǲڴ
     	// ڴ
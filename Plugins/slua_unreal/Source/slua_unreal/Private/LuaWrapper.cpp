@@ -13,6 +13,7 @@
 
 #include "LuaWrapper.h"
 #include "LuaObject.h"
+#include "LuaMathWrapper.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 namespace NS_SLUA {
@@ -47,6 +48,15 @@ namespace NS_SLUA {
 	TMap<UScriptStruct*, pushStructFunction> _pushStructMap;
 	TMap<UScriptStruct*, checkStructFunction> _checkStructMap;
 
+	// math structs are pushed by value frequently, store them in userdata block
+	DefInlineValueType(FRotator);
+	DefInlineValueType(FTransform);
+	DefInlineValueType(FLinearColor);
+	DefInlineValueType(FColor);
+	DefInlineValueType(FVector);
+	DefInlineValueType(FVector2D);
+	DefInlineValueType(FBox2D);
+
 	static inline FSlateFontInfo* __newFSlateFontInfo() {
 		return new FSlateFontInfo();
 	}
@@ -142,14 +152,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FRotator* __newFRotator() {
-		return new FRotator();
-	}
-
 	static void __pushFRotator(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFRotator();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FRotator>(L, "FRotator", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FRotator>(L, "FRotator", *reinterpret_cast<FRotator*>(parms));
 	}
 
 	static void __checkFRotator(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -161,14 +165,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FTransform* __newFTransform() {
-		return new FTransform();
-	}
-
 	static void __pushFTransform(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFTransform();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FTransform>(L, "FTransform", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FTransform>(L, "FTransform", *reinterpret_cast<FTransform*>(parms));
 	}
 
 	static void __checkFTransform(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -180,14 +178,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FLinearColor* __newFLinearColor() {
-		return new FLinearColor();
-	}
-
 	static void __pushFLinearColor(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFLinearColor();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FLinearColor>(L, "FLinearColor", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FLinearColor>(L, "FLinearColor", *reinterpret_cast<FLinearColor*>(parms));
 	}
 
 	static void __checkFLinearColor(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -199,14 +191,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FColor* __newFColor() {
-		return new FColor();
-	}
-
 	static void __pushFColor(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFColor();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FColor>(L, "FColor", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FColor>(L, "FColor", *reinterpret_cast<FColor*>(parms));
 	}
 
 	static void __checkFColor(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -218,14 +204,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FVector* __newFVector() {
-		return new FVector();
-	}
-
 	static void __pushFVector(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFVector();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FVector>(L, "FVector", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FVector>(L, "FVector", *reinterpret_cast<FVector*>(parms));
 	}
 
 	static void __checkFVector(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -237,14 +217,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FVector2D* __newFVector2D() {
-		return new FVector2D();
-	}
-
 	static void __pushFVector2D(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFVector2D();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FVector2D>(L, "FVector2D", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FVector2D>(L, "FVector2D", *reinterpret_cast<FVector2D*>(parms));
 	}
 
 	static void __checkFVector2D(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -294,14 +268,8 @@ namespace NS_SLUA {
 		p->CopyCompleteValue(parms, v);
 	}
 
-	static inline FBox2D* __newFBox2D() {
-		return new FBox2D();
-	}
-
 	static void __pushFBox2D(lua_State* L, UStructProperty* p, uint8* parms) {
-		auto ptr = __newFBox2D();
-		p->CopyCompleteValue(ptr, parms);
-		LuaObject::push<FBox2D>(L, "FBox2D", ptr, UD_AUTOGC);
+		LuaObject::pushValue<FBox2D>(L, "FBox2D", *reinterpret_cast<FBox2D*>(parms));
 	}
 
 	static void __checkFBox2D(lua_State* L, UStructProperty* p, uint8* parms, int i) {
@@ -692,9 +660,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FSlateBrush);
-				auto ret = __newFBox2D();
-				*ret = self->GetUVRegion();
-				LuaObject::push<FBox2D>(L, "FBox2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", self->GetUVRegion());
 				return 1;
 			}
 			luaL_error(L, "call FSlateBrush::GetUVRegion error, argc=%d", argc);
@@ -914,9 +880,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FMargin);
-				auto ret = __newFVector2D();
-				*ret = self->GetDesiredSize();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetDesiredSize());
 				return 1;
 			}
 			luaL_error(L, "call FMargin::GetDesiredSize error, argc=%d", argc);
@@ -1051,9 +1015,7 @@ namespace NS_SLUA {
 				CheckSelf(FGeometry);
 				auto AbsoluteCoordinate = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto AbsoluteCoordinateVal = *AbsoluteCoordinate;
-				auto ret = __newFVector2D();
-				*ret = self->AbsoluteToLocal(AbsoluteCoordinateVal);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->AbsoluteToLocal(AbsoluteCoordinateVal));
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::AbsoluteToLocal error, argc=%d", argc);
@@ -1066,9 +1028,7 @@ namespace NS_SLUA {
 				CheckSelf(FGeometry);
 				auto LocalCoordinate = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto LocalCoordinateVal = *LocalCoordinate;
-				auto ret = __newFVector2D();
-				*ret = self->LocalToAbsolute(LocalCoordinateVal);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->LocalToAbsolute(LocalCoordinateVal));
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::LocalToAbsolute error, argc=%d", argc);
@@ -1081,9 +1041,7 @@ namespace NS_SLUA {
 				CheckSelf(FGeometry);
 				auto LocalCoordinate = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto LocalCoordinateVal = *LocalCoordinate;
-				auto ret = __newFVector2D();
-				*ret = self->LocalToRoundedLocal(LocalCoordinateVal);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->LocalToRoundedLocal(LocalCoordinateVal));
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::LocalToRoundedLocal error, argc=%d", argc);
@@ -1106,9 +1064,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FGeometry);
-				auto ret = __newFVector2D();
-				*ret = self->GetDrawSize();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetDrawSize());
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetDrawSize error, argc=%d", argc);
@@ -1119,9 +1075,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FGeometry);
-				auto ret = __newFVector2D();
-				*ret = self->GetLocalSize();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetLocalSize());
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetLocalSize error, argc=%d", argc);
@@ -1132,9 +1086,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FGeometry);
-				auto ret = __newFVector2D();
-				*ret = self->GetAbsolutePosition();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetAbsolutePosition());
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetAbsolutePosition error, argc=%d", argc);
@@ -1145,9 +1097,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FGeometry);
-				auto ret = __newFVector2D();
-				*ret = self->GetAbsoluteSize();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetAbsoluteSize());
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetAbsoluteSize error, argc=%d", argc);
@@ -1160,9 +1110,7 @@ namespace NS_SLUA {
 				CheckSelf(FGeometry);
 				auto NormalCoordinates = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& NormalCoordinatesRef = *NormalCoordinates;
-				auto ret = __newFVector2D();
-				*ret = self->GetAbsolutePositionAtCoordinates(NormalCoordinatesRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetAbsolutePositionAtCoordinates(NormalCoordinatesRef));
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetAbsolutePositionAtCoordinates error, argc=%d", argc);
@@ -1175,9 +1123,7 @@ namespace NS_SLUA {
 				CheckSelf(FGeometry);
 				auto NormalCoordinates = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& NormalCoordinatesRef = *NormalCoordinates;
-				auto ret = __newFVector2D();
-				*ret = self->GetLocalPositionAtCoordinates(NormalCoordinatesRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetLocalPositionAtCoordinates(NormalCoordinatesRef));
 				return 1;
 			}
 			luaL_error(L, "call FGeometry::GetLocalPositionAtCoordinates error, argc=%d", argc);
@@ -1266,9 +1212,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FSlateColor);
-				auto ret = __newFLinearColor();
-				*ret = self->GetSpecifiedColor();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->GetSpecifiedColor());
 				return 1;
 			}
 			luaL_error(L, "call FSlateColor::GetSpecifiedColor error, argc=%d", argc);
@@ -1329,22 +1273,19 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FRotator();
-				LuaObject::push<FRotator>(L, "FRotator", self, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", FRotator());
 				return 1;
 			}
 			if (argc == 2) {
 				auto InF = LuaObject::checkValue<float>(L, 2);
-				auto self = new FRotator(InF);
-				LuaObject::push<FRotator>(L, "FRotator", self, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", FRotator(InF));
 				return 1;
 			}
 			if (argc == 4) {
 				auto InPitch = LuaObject::checkValue<float>(L, 2);
 				auto InYaw = LuaObject::checkValue<float>(L, 3);
 				auto InRoll = LuaObject::checkValue<float>(L, 4);
-				auto self = new FRotator(InPitch, InYaw, InRoll);
-				LuaObject::push<FRotator>(L, "FRotator", self, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", FRotator(InPitch, InYaw, InRoll));
 				return 1;
 			}
 			luaL_error(L, "call FRotator() error, argc=%d", argc);
@@ -1363,9 +1304,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FRotator")) {
 				auto R = LuaObject::checkValue<FRotator*>(L, 2);
 				auto& RRef = *R;
-				auto ret = __newFRotator();
-				*ret = (*self + RRef);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", (*self + RRef));
 				return 1;
 			}
 			luaL_error(L, "FRotator operator__add error, arg=%d", lua_typename(L, 2));
@@ -1377,9 +1316,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FRotator")) {
 				auto R = LuaObject::checkValue<FRotator*>(L, 2);
 				auto& RRef = *R;
-				auto ret = __newFRotator();
-				*ret = (*self - RRef);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", (*self - RRef));
 				return 1;
 			}
 			luaL_error(L, "FRotator operator__sub error, arg=%d", lua_typename(L, 2));
@@ -1390,9 +1327,7 @@ namespace NS_SLUA {
 			CheckSelf(FRotator);
 			if (lua_isnumber(L, 2)) {
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFRotator();
-				*ret = (*self * Scale);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", (*self * Scale));
 				return 1;
 			}
 			luaL_error(L, "FRotator operator__mul error, arg=%d", lua_typename(L, 2));
@@ -1531,9 +1466,7 @@ namespace NS_SLUA {
 				auto DeltaPitch = LuaObject::checkValue<float>(L, 2);
 				auto DeltaYaw = LuaObject::checkValue<float>(L, 3);
 				auto DeltaRoll = LuaObject::checkValue<float>(L, 4);
-				auto ret = __newFRotator();
-				*ret = self->Add(DeltaPitch, DeltaYaw, DeltaRoll);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->Add(DeltaPitch, DeltaYaw, DeltaRoll));
 				return 1;
 			}
 			luaL_error(L, "call FRotator::Add error, argc=%d", argc);
@@ -1544,9 +1477,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFRotator();
-				*ret = self->GetInverse();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->GetInverse());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::GetInverse error, argc=%d", argc);
@@ -1559,9 +1490,7 @@ namespace NS_SLUA {
 				CheckSelf(FRotator);
 				auto RotGrid = LuaObject::checkValue<FRotator*>(L, 2);
 				auto& RotGridRef = *RotGrid;
-				auto ret = __newFRotator();
-				*ret = self->GridSnap(RotGridRef);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->GridSnap(RotGridRef));
 				return 1;
 			}
 			luaL_error(L, "call FRotator::GridSnap error, argc=%d", argc);
@@ -1572,9 +1501,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFVector();
-				*ret = self->Vector();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->Vector());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::Vector error, argc=%d", argc);
@@ -1585,9 +1512,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFVector();
-				*ret = self->Euler();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->Euler());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::Euler error, argc=%d", argc);
@@ -1600,9 +1525,7 @@ namespace NS_SLUA {
 				CheckSelf(FRotator);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->RotateVector(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->RotateVector(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FRotator::RotateVector error, argc=%d", argc);
@@ -1615,9 +1538,7 @@ namespace NS_SLUA {
 				CheckSelf(FRotator);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->UnrotateVector(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->UnrotateVector(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FRotator::UnrotateVector error, argc=%d", argc);
@@ -1628,9 +1549,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFRotator();
-				*ret = self->Clamp();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->Clamp());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::Clamp error, argc=%d", argc);
@@ -1641,9 +1560,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFRotator();
-				*ret = self->GetNormalized();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->GetNormalized());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::GetNormalized error, argc=%d", argc);
@@ -1654,9 +1571,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRotator);
-				auto ret = __newFRotator();
-				*ret = self->GetDenormalized();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->GetDenormalized());
 				return 1;
 			}
 			luaL_error(L, "call FRotator::GetDenormalized error, argc=%d", argc);
@@ -1847,9 +1762,7 @@ namespace NS_SLUA {
 			if (argc == 1) {
 				auto Euler = LuaObject::checkValue<FVector*>(L, 1);
 				auto& EulerRef = *Euler;
-				auto ret = __newFRotator();
-				*ret = FRotator::MakeFromEuler(EulerRef);
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", FRotator::MakeFromEuler(EulerRef));
 				return 1;
 			}
 			luaL_error(L, "call FRotator::MakeFromEuler error, argc=%d", argc);
@@ -1859,6 +1772,7 @@ namespace NS_SLUA {
 		static void bind(lua_State* L) {
 			AutoStack autoStack(L);
 			LuaObject::newType(L, "FRotator");
+			MathInPlaceWrapper<FRotator>::bind(L);
 			LuaObject::addOperator(L, "__add", __add);
 			LuaObject::addOperator(L, "__sub", __sub);
 			LuaObject::addOperator(L, "__mul", __mul);
@@ -1906,15 +1820,13 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FTransform();
-				LuaObject::push<FTransform>(L, "FTransform", self, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", FTransform());
 				return 1;
 			}
 			if (argc == 2) {
 				auto InTranslation = LuaObject::checkValue<FVector*>(L, 2);
 				auto& InTranslationRef = *InTranslation;
-				auto self = new FTransform(InTranslationRef);
-				LuaObject::push<FTransform>(L, "FTransform", self, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", FTransform(InTranslationRef));
 				return 1;
 			}
 			if (argc == 5) {
@@ -1926,8 +1838,7 @@ namespace NS_SLUA {
 				auto& InZRef = *InZ;
 				auto InTranslation = LuaObject::checkValue<FVector*>(L, 5);
 				auto& InTranslationRef = *InTranslation;
-				auto self = new FTransform(InXRef, InYRef, InZRef, InTranslationRef);
-				LuaObject::push<FTransform>(L, "FTransform", self, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", FTransform(InXRef, InYRef, InZRef, InTranslationRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform() error, argc=%d", argc);
@@ -1946,9 +1857,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FTransform")) {
 				auto Atom = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& AtomRef = *Atom;
-				auto ret = __newFTransform();
-				*ret = (*self + AtomRef);
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", (*self + AtomRef));
 				return 1;
 			}
 			luaL_error(L, "FTransform operator__add error, arg=%d", lua_typename(L, 2));
@@ -1960,9 +1869,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FTransform")) {
 				auto Other = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFTransform();
-				*ret = (*self * OtherRef);
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", (*self * OtherRef));
 				return 1;
 			}
 			luaL_error(L, "FTransform operator__mul error, arg=%d", lua_typename(L, 2));
@@ -2082,9 +1989,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FTransform);
-				auto ret = __newFTransform();
-				*ret = self->Inverse();
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", self->Inverse());
 				return 1;
 			}
 			luaL_error(L, "call FTransform::Inverse error, argc=%d", argc);
@@ -2176,9 +2081,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto Other = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFTransform();
-				*ret = self->GetRelativeTransform(OtherRef);
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", self->GetRelativeTransform(OtherRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetRelativeTransform error, argc=%d", argc);
@@ -2191,9 +2094,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto Other = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFTransform();
-				*ret = self->GetRelativeTransformReverse(OtherRef);
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", self->GetRelativeTransformReverse(OtherRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetRelativeTransformReverse error, argc=%d", argc);
@@ -2219,9 +2120,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->TransformPosition(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->TransformPosition(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::TransformPosition error, argc=%d", argc);
@@ -2234,9 +2133,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->TransformPositionNoScale(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->TransformPositionNoScale(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::TransformPositionNoScale error, argc=%d", argc);
@@ -2249,9 +2146,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->InverseTransformPosition(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->InverseTransformPosition(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::InverseTransformPosition error, argc=%d", argc);
@@ -2264,9 +2159,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->InverseTransformPositionNoScale(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->InverseTransformPositionNoScale(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::InverseTransformPositionNoScale error, argc=%d", argc);
@@ -2279,9 +2172,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->TransformVector(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->TransformVector(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::TransformVector error, argc=%d", argc);
@@ -2294,9 +2185,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->TransformVectorNoScale(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->TransformVectorNoScale(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::TransformVectorNoScale error, argc=%d", argc);
@@ -2309,9 +2198,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->InverseTransformVector(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->InverseTransformVector(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::InverseTransformVector error, argc=%d", argc);
@@ -2324,9 +2211,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = self->InverseTransformVectorNoScale(VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->InverseTransformVectorNoScale(VRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::InverseTransformVectorNoScale error, argc=%d", argc);
@@ -2338,9 +2223,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FTransform);
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFTransform();
-				*ret = self->GetScaled(Scale);
-				LuaObject::push<FTransform>(L, "FTransform", ret, UD_AUTOGC);
+				LuaObject::pushValue<FTransform>(L, "FTransform", self->GetScaled(Scale));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetScaled error, argc=%d", argc);
@@ -2353,9 +2236,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto InAxis = LuaObject::checkValue<int>(L, 2);
 				auto InAxisVal = (EAxis::Type)InAxis;
-				auto ret = __newFVector();
-				*ret = self->GetScaledAxis(InAxisVal);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetScaledAxis(InAxisVal));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetScaledAxis error, argc=%d", argc);
@@ -2368,9 +2249,7 @@ namespace NS_SLUA {
 				CheckSelf(FTransform);
 				auto InAxis = LuaObject::checkValue<int>(L, 2);
 				auto InAxisVal = (EAxis::Type)InAxis;
-				auto ret = __newFVector();
-				*ret = self->GetUnitAxis(InAxisVal);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetUnitAxis(InAxisVal));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetUnitAxis error, argc=%d", argc);
@@ -2396,9 +2275,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FTransform);
-				auto ret = __newFVector();
-				*ret = self->GetLocation();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetLocation());
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetLocation error, argc=%d", argc);
@@ -2409,9 +2286,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FTransform);
-				auto ret = __newFRotator();
-				*ret = self->Rotator();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->Rotator());
 				return 1;
 			}
 			luaL_error(L, "call FTransform::Rotator error, argc=%d", argc);
@@ -2686,9 +2561,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FTransform);
-				auto ret = __newFVector();
-				*ret = self->GetTranslation();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetTranslation());
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetTranslation error, argc=%d", argc);
@@ -2699,9 +2572,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FTransform);
-				auto ret = __newFVector();
-				*ret = self->GetScale3D();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetScale3D());
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetScale3D error, argc=%d", argc);
@@ -2755,9 +2626,7 @@ namespace NS_SLUA {
 				auto InScale = LuaObject::checkValue<FVector*>(L, 1);
 				auto& InScaleRef = *InScale;
 				auto Tolerance = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = FTransform::GetSafeScaleReciprocal(InScaleRef, Tolerance);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FTransform::GetSafeScaleReciprocal(InScaleRef, Tolerance));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::GetSafeScaleReciprocal error, argc=%d", argc);
@@ -2819,9 +2688,7 @@ namespace NS_SLUA {
 				auto& ARef = *A;
 				auto B = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& BRef = *B;
-				auto ret = __newFVector();
-				*ret = FTransform::AddTranslations(ARef, BRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FTransform::AddTranslations(ARef, BRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::AddTranslations error, argc=%d", argc);
@@ -2835,9 +2702,7 @@ namespace NS_SLUA {
 				auto& ARef = *A;
 				auto B = LuaObject::checkValue<FTransform*>(L, 2);
 				auto& BRef = *B;
-				auto ret = __newFVector();
-				*ret = FTransform::SubtractTranslations(ARef, BRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FTransform::SubtractTranslations(ARef, BRef));
 				return 1;
 			}
 			luaL_error(L, "call FTransform::SubtractTranslations error, argc=%d", argc);
@@ -2924,15 +2789,13 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FLinearColor();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor());
 				return 1;
 			}
 			if (argc == 2) {
 				auto _a0 = LuaObject::checkValue<int>(L, 2);
 				auto _a0Val = (EForceInit)_a0;
-				auto self = new FLinearColor(_a0Val);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor(_a0Val));
 				return 1;
 			}
 			if (argc == 5) {
@@ -2940,8 +2803,7 @@ namespace NS_SLUA {
 				auto InG = LuaObject::checkValue<float>(L, 3);
 				auto InB = LuaObject::checkValue<float>(L, 4);
 				auto InA = LuaObject::checkValue<float>(L, 5);
-				auto self = new FLinearColor(InR, InG, InB, InA);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor(InR, InG, InB, InA));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor() error, argc=%d", argc);
@@ -2960,9 +2822,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FLinearColor")) {
 				auto ColorB = LuaObject::checkValue<FLinearColor*>(L, 2);
 				auto& ColorBRef = *ColorB;
-				auto ret = __newFLinearColor();
-				*ret = (*self + ColorBRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self + ColorBRef));
 				return 1;
 			}
 			luaL_error(L, "FLinearColor operator__add error, arg=%d", lua_typename(L, 2));
@@ -2974,9 +2834,7 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FLinearColor")) {
 				auto ColorB = LuaObject::checkValue<FLinearColor*>(L, 2);
 				auto& ColorBRef = *ColorB;
-				auto ret = __newFLinearColor();
-				*ret = (*self - ColorBRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self - ColorBRef));
 				return 1;
 			}
 			luaL_error(L, "FLinearColor operator__sub error, arg=%d", lua_typename(L, 2));
@@ -2988,16 +2846,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FLinearColor")) {
 				auto ColorB = LuaObject::checkValue<FLinearColor*>(L, 2);
 				auto& ColorBRef = *ColorB;
-				auto ret = __newFLinearColor();
-				*ret = (*self * ColorBRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self * ColorBRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto Scalar = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFLinearColor();
-				*ret = (*self * Scalar);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self * Scalar));
 				return 1;
 			}
 			luaL_error(L, "FLinearColor operator__mul error, arg=%d", lua_typename(L, 2));
@@ -3009,16 +2863,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FLinearColor")) {
 				auto ColorB = LuaObject::checkValue<FLinearColor*>(L, 2);
 				auto& ColorBRef = *ColorB;
-				auto ret = __newFLinearColor();
-				*ret = (*self / ColorBRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self / ColorBRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto Scalar = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFLinearColor();
-				*ret = (*self / Scalar);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", (*self / Scalar));
 				return 1;
 			}
 			luaL_error(L, "FLinearColor operator__div error, arg=%d", lua_typename(L, 2));
@@ -3154,9 +3004,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FLinearColor);
-				auto ret = __newFColor();
-				*ret = self->ToRGBE();
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", self->ToRGBE());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::ToRGBE error, argc=%d", argc);
@@ -3182,9 +3030,7 @@ namespace NS_SLUA {
 				CheckSelf(FLinearColor);
 				auto InMin = LuaObject::checkValue<float>(L, 2);
 				auto InMax = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFLinearColor();
-				*ret = self->GetClamped(InMin, InMax);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->GetClamped(InMin, InMax));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::GetClamped error, argc=%d", argc);
@@ -3211,9 +3057,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FLinearColor);
 				auto NewOpacicty = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFLinearColor();
-				*ret = self->CopyWithNewOpacity(NewOpacicty);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->CopyWithNewOpacity(NewOpacicty));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::CopyWithNewOpacity error, argc=%d", argc);
@@ -3224,9 +3068,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FLinearColor);
-				auto ret = __newFLinearColor();
-				*ret = self->LinearRGBToHSV();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->LinearRGBToHSV());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::LinearRGBToHSV error, argc=%d", argc);
@@ -3237,9 +3079,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FLinearColor);
-				auto ret = __newFLinearColor();
-				*ret = self->HSVToLinearRGB();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->HSVToLinearRGB());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::HSVToLinearRGB error, argc=%d", argc);
@@ -3250,9 +3090,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FLinearColor);
-				auto ret = __newFColor();
-				*ret = self->Quantize();
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", self->Quantize());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::Quantize error, argc=%d", argc);
@@ -3263,9 +3101,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FLinearColor);
-				auto ret = __newFColor();
-				*ret = self->QuantizeRound();
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", self->QuantizeRound());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::QuantizeRound error, argc=%d", argc);
@@ -3277,9 +3113,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FLinearColor);
 				auto bSRGB = LuaObject::checkValue<bool>(L, 2);
-				auto ret = __newFColor();
-				*ret = self->ToFColor(bSRGB);
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", self->ToFColor(bSRGB));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::ToFColor error, argc=%d", argc);
@@ -3291,9 +3125,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FLinearColor);
 				auto Desaturation = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFLinearColor();
-				*ret = self->Desaturate(Desaturation);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->Desaturate(Desaturation));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::Desaturate error, argc=%d", argc);
@@ -3390,9 +3222,7 @@ namespace NS_SLUA {
 			if (argc == 1) {
 				auto Color = LuaObject::checkValue<FColor*>(L, 1);
 				auto& ColorRef = *Color;
-				auto ret = __newFLinearColor();
-				*ret = FLinearColor::FromSRGBColor(ColorRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::FromSRGBColor(ColorRef));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::FromSRGBColor error, argc=%d", argc);
@@ -3404,9 +3234,7 @@ namespace NS_SLUA {
 			if (argc == 1) {
 				auto Color = LuaObject::checkValue<FColor*>(L, 1);
 				auto& ColorRef = *Color;
-				auto ret = __newFLinearColor();
-				*ret = FLinearColor::FromPow22Color(ColorRef);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::FromPow22Color(ColorRef));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::FromPow22Color error, argc=%d", argc);
@@ -3422,13 +3250,11 @@ namespace NS_SLUA {
 				auto SVal = (unsigned char)S;
 				auto V = LuaObject::checkValue<int>(L, 3);
 				auto VVal = (unsigned char)V;
-				auto ret = __newFLinearColor();
 #if (ENGINE_MINOR_VERSION>=22) && (ENGINE_MAJOR_VERSION>=4)
-				*ret = FLinearColor::MakeFromHSV8(HVal, SVal, VVal);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::MakeFromHSV8(HVal, SVal, VVal));
 #else
-				*ret = FLinearColor::FGetHSV(HVal, SVal, VVal);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::FGetHSV(HVal, SVal, VVal));
 #endif
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::FGetHSV error, argc=%d", argc);
@@ -3438,9 +3264,7 @@ namespace NS_SLUA {
 		static int MakeRandomColor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 0) {
-				auto ret = __newFLinearColor();
-				*ret = FLinearColor::MakeRandomColor();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::MakeRandomColor());
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::MakeRandomColor error, argc=%d", argc);
@@ -3451,9 +3275,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				auto Temp = LuaObject::checkValue<float>(L, 1);
-				auto ret = __newFLinearColor();
-				*ret = FLinearColor::MakeFromColorTemperature(Temp);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::MakeFromColorTemperature(Temp));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::MakeFromColorTemperature error, argc=%d", argc);
@@ -3483,9 +3305,7 @@ namespace NS_SLUA {
 				auto To = LuaObject::checkValue<FLinearColor*>(L, 2);
 				auto& ToRef = *To;
 				auto Progress = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFLinearColor();
-				*ret = FLinearColor::LerpUsingHSV(FromRef, ToRef, Progress);
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", FLinearColor::LerpUsingHSV(FromRef, ToRef, Progress));
 				return 1;
 			}
 			luaL_error(L, "call FLinearColor::LerpUsingHSV error, argc=%d", argc);
@@ -3495,6 +3315,7 @@ namespace NS_SLUA {
 		static void bind(lua_State* L) {
 			AutoStack autoStack(L);
 			LuaObject::newType(L, "FLinearColor");
+			MathInPlaceWrapper<FLinearColor>::bind(L);
 			LuaObject::addOperator(L, "__add", __add);
 			LuaObject::addOperator(L, "__sub", __sub);
 			LuaObject::addOperator(L, "__mul", __mul);
@@ -3547,15 +3368,13 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FColor();
-				LuaObject::push<FColor>(L, "FColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor());
 				return 1;
 			}
 			if (argc == 2) {
 				auto _a0 = LuaObject::checkValue<int>(L, 2);
 				auto _a0Val = (EForceInit)_a0;
-				auto self = new FColor(_a0Val);
-				LuaObject::push<FColor>(L, "FColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor(_a0Val));
 				return 1;
 			}
 			if (argc == 5) {
@@ -3567,8 +3386,7 @@ namespace NS_SLUA {
 				auto InBVal = (unsigned char)InB;
 				auto InA = LuaObject::checkValue<int>(L, 5);
 				auto InAVal = (unsigned char)InA;
-				auto self = new FColor(InRVal, InGVal, InBVal, InAVal);
-				LuaObject::push<FColor>(L, "FColor", self, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor(InRVal, InGVal, InBVal, InAVal));
 				return 1;
 			}
 			luaL_error(L, "call FColor() error, argc=%d", argc);
@@ -3695,9 +3513,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FColor);
-				auto ret = __newFLinearColor();
-				*ret = self->FromRGBE();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->FromRGBE());
 				return 1;
 			}
 			luaL_error(L, "call FColor::FromRGBE error, argc=%d", argc);
@@ -3710,9 +3526,7 @@ namespace NS_SLUA {
 				CheckSelf(FColor);
 				auto Alpha = LuaObject::checkValue<int>(L, 2);
 				auto AlphaVal = (unsigned char)Alpha;
-				auto ret = __newFColor();
-				*ret = self->WithAlpha(AlphaVal);
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", self->WithAlpha(AlphaVal));
 				return 1;
 			}
 			luaL_error(L, "call FColor::WithAlpha error, argc=%d", argc);
@@ -3723,9 +3537,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FColor);
-				auto ret = __newFLinearColor();
-				*ret = self->ReinterpretAsLinear();
-				LuaObject::push<FLinearColor>(L, "FLinearColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FLinearColor>(L, "FLinearColor", self->ReinterpretAsLinear());
 				return 1;
 			}
 			luaL_error(L, "call FColor::ReinterpretAsLinear error, argc=%d", argc);
@@ -3821,9 +3633,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				auto HexString = LuaObject::checkValue<FString>(L, 1);
-				auto ret = __newFColor();
-				*ret = FColor::FromHex(HexString);
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor::FromHex(HexString));
 				return 1;
 			}
 			luaL_error(L, "call FColor::FromHex error, argc=%d", argc);
@@ -3833,9 +3643,7 @@ namespace NS_SLUA {
 		static int MakeRandomColor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 0) {
-				auto ret = __newFColor();
-				*ret = FColor::MakeRandomColor();
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor::MakeRandomColor());
 				return 1;
 			}
 			luaL_error(L, "call FColor::MakeRandomColor error, argc=%d", argc);
@@ -3846,9 +3654,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				auto Scalar = LuaObject::checkValue<float>(L, 1);
-				auto ret = __newFColor();
-				*ret = FColor::MakeRedToGreenColorFromScalar(Scalar);
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor::MakeRedToGreenColorFromScalar(Scalar));
 				return 1;
 			}
 			luaL_error(L, "call FColor::MakeRedToGreenColorFromScalar error, argc=%d", argc);
@@ -3859,9 +3665,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				auto Temp = LuaObject::checkValue<float>(L, 1);
-				auto ret = __newFColor();
-				*ret = FColor::MakeFromColorTemperature(Temp);
-				LuaObject::push<FColor>(L, "FColor", ret, UD_AUTOGC);
+				LuaObject::pushValue<FColor>(L, "FColor", FColor::MakeFromColorTemperature(Temp));
 				return 1;
 			}
 			luaL_error(L, "call FColor::MakeFromColorTemperature error, argc=%d", argc);
@@ -3911,30 +3715,26 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FVector();
-				LuaObject::push<FVector>(L, "FVector", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector());
 				return 1;
 			}
 			if (argc == 2) {
 				auto InF = LuaObject::checkValue<float>(L, 2);
-				auto self = new FVector(InF);
-				LuaObject::push<FVector>(L, "FVector", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector(InF));
 				return 1;
 			}
 			if (argc == 3) {
 				auto V = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto VVal = *V;
 				auto InZ = LuaObject::checkValue<float>(L, 3);
-				auto self = new FVector(VVal, InZ);
-				LuaObject::push<FVector>(L, "FVector", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector(VVal, InZ));
 				return 1;
 			}
 			if (argc == 4) {
 				auto InX = LuaObject::checkValue<float>(L, 2);
 				auto InY = LuaObject::checkValue<float>(L, 3);
 				auto InZ = LuaObject::checkValue<float>(L, 4);
-				auto self = new FVector(InX, InY, InZ);
-				LuaObject::push<FVector>(L, "FVector", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector(InX, InY, InZ));
 				return 1;
 			}
 			luaL_error(L, "call FVector() error, argc=%d", argc);
@@ -3953,16 +3753,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FVector")) {
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = (*self + VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self + VRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto Bias = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = (*self + Bias);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self + Bias));
 				return 1;
 			}
 			luaL_error(L, "FVector operator__add error, arg=%d", lua_typename(L, 2));
@@ -3974,16 +3770,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FVector")) {
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = (*self - VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self - VRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto Bias = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = (*self - Bias);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self - Bias));
 				return 1;
 			}
 			luaL_error(L, "FVector operator__sub error, arg=%d", lua_typename(L, 2));
@@ -3994,17 +3786,13 @@ namespace NS_SLUA {
 			CheckSelf(FVector);
 			if (lua_isnumber(L, 2)) {
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = (*self * Scale);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self * Scale));
 				return 1;
 			}
 			if (LuaObject::matchType(L, 2, "FVector")) {
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = (*self * VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self * VRef));
 				return 1;
 			}
 			luaL_error(L, "FVector operator__mul error, arg=%d", lua_typename(L, 2));
@@ -4015,17 +3803,13 @@ namespace NS_SLUA {
 			CheckSelf(FVector);
 			if (lua_isnumber(L, 2)) {
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = (*self / Scale);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self / Scale));
 				return 1;
 			}
 			if (LuaObject::matchType(L, 2, "FVector")) {
 				auto V = LuaObject::checkValue<FVector*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector();
-				*ret = (*self / VRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", (*self / VRef));
 				return 1;
 			}
 			luaL_error(L, "FVector operator__div error, arg=%d", lua_typename(L, 2));
@@ -4278,9 +4062,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto Other = LuaObject::checkValue<FVector*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFVector();
-				*ret = self->ComponentMin(OtherRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->ComponentMin(OtherRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::ComponentMin error, argc=%d", argc);
@@ -4293,9 +4075,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto Other = LuaObject::checkValue<FVector*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFVector();
-				*ret = self->ComponentMax(OtherRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->ComponentMax(OtherRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::ComponentMax error, argc=%d", argc);
@@ -4306,9 +4086,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector();
-				*ret = self->GetAbs();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetAbs());
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetAbs error, argc=%d", argc);
@@ -4433,9 +4211,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector();
-				*ret = self->GetSignVector();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetSignVector());
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetSignVector error, argc=%d", argc);
@@ -4446,9 +4222,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector();
-				*ret = self->Projection();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->Projection());
 				return 1;
 			}
 			luaL_error(L, "call FVector::Projection error, argc=%d", argc);
@@ -4459,9 +4233,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector();
-				*ret = self->GetUnsafeNormal();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetUnsafeNormal());
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetUnsafeNormal error, argc=%d", argc);
@@ -4473,9 +4245,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto GridSz = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->GridSnap(GridSz);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GridSnap(GridSz));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GridSnap error, argc=%d", argc);
@@ -4487,9 +4257,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto Radius = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->BoundToCube(Radius);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->BoundToCube(Radius));
 				return 1;
 			}
 			luaL_error(L, "call FVector::BoundToCube error, argc=%d", argc);
@@ -4502,9 +4270,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto Min = LuaObject::checkValue<float>(L, 2);
 				auto Max = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFVector();
-				*ret = self->GetClampedToSize(Min, Max);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetClampedToSize(Min, Max));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetClampedToSize error, argc=%d", argc);
@@ -4517,9 +4283,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto Min = LuaObject::checkValue<float>(L, 2);
 				auto Max = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFVector();
-				*ret = self->GetClampedToSize2D(Min, Max);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetClampedToSize2D(Min, Max));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetClampedToSize2D error, argc=%d", argc);
@@ -4531,9 +4295,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto MaxSize = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->GetClampedToMaxSize(MaxSize);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetClampedToMaxSize(MaxSize));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetClampedToMaxSize error, argc=%d", argc);
@@ -4545,9 +4307,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto MaxSize = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->GetClampedToMaxSize2D(MaxSize);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetClampedToMaxSize2D(MaxSize));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetClampedToMaxSize2D error, argc=%d", argc);
@@ -4572,9 +4332,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector();
-				*ret = self->Reciprocal();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->Reciprocal());
 				return 1;
 			}
 			luaL_error(L, "call FVector::Reciprocal error, argc=%d", argc);
@@ -4600,9 +4358,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto MirrorNormal = LuaObject::checkValue<FVector*>(L, 2);
 				auto& MirrorNormalRef = *MirrorNormal;
-				auto ret = __newFVector();
-				*ret = self->MirrorByVector(MirrorNormalRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->MirrorByVector(MirrorNormalRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::MirrorByVector error, argc=%d", argc);
@@ -4616,9 +4372,7 @@ namespace NS_SLUA {
 				auto AngleDeg = LuaObject::checkValue<float>(L, 2);
 				auto Axis = LuaObject::checkValue<FVector*>(L, 3);
 				auto& AxisRef = *Axis;
-				auto ret = __newFVector();
-				*ret = self->RotateAngleAxis(AngleDeg, AxisRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->RotateAngleAxis(AngleDeg, AxisRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::RotateAngleAxis error, argc=%d", argc);
@@ -4630,9 +4384,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto Tolerance = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->GetSafeNormal(Tolerance);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetSafeNormal(Tolerance));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetSafeNormal error, argc=%d", argc);
@@ -4644,9 +4396,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector);
 				auto Tolerance = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector();
-				*ret = self->GetSafeNormal2D(Tolerance);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetSafeNormal2D(Tolerance));
 				return 1;
 			}
 			luaL_error(L, "call FVector::GetSafeNormal2D error, argc=%d", argc);
@@ -4673,9 +4423,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto A = LuaObject::checkValue<FVector*>(L, 2);
 				auto& ARef = *A;
-				auto ret = __newFVector();
-				*ret = self->ProjectOnTo(ARef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->ProjectOnTo(ARef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::ProjectOnTo error, argc=%d", argc);
@@ -4688,9 +4436,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector);
 				auto Normal = LuaObject::checkValue<FVector*>(L, 2);
 				auto& NormalRef = *Normal;
-				auto ret = __newFVector();
-				*ret = self->ProjectOnToNormal(NormalRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->ProjectOnToNormal(NormalRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::ProjectOnToNormal error, argc=%d", argc);
@@ -4701,9 +4447,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFRotator();
-				*ret = self->ToOrientationRotator();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->ToOrientationRotator());
 				return 1;
 			}
 			luaL_error(L, "call FVector::ToOrientationRotator error, argc=%d", argc);
@@ -4714,9 +4458,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFRotator();
-				*ret = self->Rotation();
-				LuaObject::push<FRotator>(L, "FRotator", ret, UD_AUTOGC);
+				LuaObject::pushValue<FRotator>(L, "FRotator", self->Rotation());
 				return 1;
 			}
 			luaL_error(L, "call FVector::Rotation error, argc=%d", argc);
@@ -4817,9 +4559,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector);
-				auto ret = __newFVector2D();
-				*ret = self->UnitCartesianToSpherical();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->UnitCartesianToSpherical());
 				return 1;
 			}
 			luaL_error(L, "call FVector::UnitCartesianToSpherical error, argc=%d", argc);
@@ -4845,9 +4585,7 @@ namespace NS_SLUA {
 				auto& ARef = *A;
 				auto B = LuaObject::checkValue<FVector*>(L, 2);
 				auto& BRef = *B;
-				auto ret = __newFVector();
-				*ret = FVector::CrossProduct(ARef, BRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::CrossProduct(ARef, BRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::CrossProduct error, argc=%d", argc);
@@ -4945,9 +4683,7 @@ namespace NS_SLUA {
 				auto& PlaneBaseRef = *PlaneBase;
 				auto PlaneNormal = LuaObject::checkValue<FVector*>(L, 3);
 				auto& PlaneNormalRef = *PlaneNormal;
-				auto ret = __newFVector();
-				*ret = FVector::PointPlaneProject(PointRef, PlaneBaseRef, PlaneNormalRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::PointPlaneProject(PointRef, PlaneBaseRef, PlaneNormalRef));
 				return 1;
 			}
 			if (argc == 4) {
@@ -4959,9 +4695,7 @@ namespace NS_SLUA {
 				auto& BRef = *B;
 				auto C = LuaObject::checkValue<FVector*>(L, 4);
 				auto& CRef = *C;
-				auto ret = __newFVector();
-				*ret = FVector::PointPlaneProject(PointRef, ARef, BRef, CRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::PointPlaneProject(PointRef, ARef, BRef, CRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::PointPlaneProject error, argc=%d", argc);
@@ -4975,9 +4709,7 @@ namespace NS_SLUA {
 				auto& VRef = *V;
 				auto PlaneNormal = LuaObject::checkValue<FVector*>(L, 2);
 				auto& PlaneNormalRef = *PlaneNormal;
-				auto ret = __newFVector();
-				*ret = FVector::VectorPlaneProject(VRef, PlaneNormalRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::VectorPlaneProject(VRef, PlaneNormalRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::VectorPlaneProject error, argc=%d", argc);
@@ -5194,9 +4926,7 @@ namespace NS_SLUA {
 			if (argc == 1) {
 				auto RadVector = LuaObject::checkValue<FVector*>(L, 1);
 				auto& RadVectorRef = *RadVector;
-				auto ret = __newFVector();
-				*ret = FVector::RadiansToDegrees(RadVectorRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::RadiansToDegrees(RadVectorRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::RadiansToDegrees error, argc=%d", argc);
@@ -5208,9 +4938,7 @@ namespace NS_SLUA {
 			if (argc == 1) {
 				auto DegVector = LuaObject::checkValue<FVector*>(L, 1);
 				auto& DegVectorRef = *DegVector;
-				auto ret = __newFVector();
-				*ret = FVector::DegreesToRadians(DegVectorRef);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", FVector::DegreesToRadians(DegVectorRef));
 				return 1;
 			}
 			luaL_error(L, "call FVector::DegreesToRadians error, argc=%d", argc);
@@ -5220,6 +4948,7 @@ namespace NS_SLUA {
 		static void bind(lua_State* L) {
 			AutoStack autoStack(L);
 			LuaObject::newType(L, "FVector");
+			MathInPlaceWrapper<FVector>::bind(L);
 			LuaObject::addOperator(L, "__add", __add);
 			LuaObject::addOperator(L, "__sub", __sub);
 			LuaObject::addOperator(L, "__mul", __mul);
@@ -5319,22 +5048,19 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FVector2D();
-				LuaObject::push<FVector2D>(L, "FVector2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", FVector2D());
 				return 1;
 			}
 			if (argc == 2) {
 				auto _a0 = LuaObject::checkValue<int>(L, 2);
 				auto _a0Val = (EForceInit)_a0;
-				auto self = new FVector2D(_a0Val);
-				LuaObject::push<FVector2D>(L, "FVector2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", FVector2D(_a0Val));
 				return 1;
 			}
 			if (argc == 3) {
 				auto InX = LuaObject::checkValue<float>(L, 2);
 				auto InY = LuaObject::checkValue<float>(L, 3);
-				auto self = new FVector2D(InX, InY);
-				LuaObject::push<FVector2D>(L, "FVector2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", FVector2D(InX, InY));
 				return 1;
 			}
 			luaL_error(L, "call FVector2D() error, argc=%d", argc);
@@ -5353,16 +5079,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FVector2D")) {
 				auto V = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector2D();
-				*ret = (*self + VRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self + VRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto A = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = (*self + A);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self + A));
 				return 1;
 			}
 			luaL_error(L, "FVector2D operator__add error, arg=%d", lua_typename(L, 2));
@@ -5374,16 +5096,12 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FVector2D")) {
 				auto V = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector2D();
-				*ret = (*self - VRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self - VRef));
 				return 1;
 			}
 			if (lua_isnumber(L, 2)) {
 				auto A = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = (*self - A);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self - A));
 				return 1;
 			}
 			luaL_error(L, "FVector2D operator__sub error, arg=%d", lua_typename(L, 2));
@@ -5394,17 +5112,13 @@ namespace NS_SLUA {
 			CheckSelf(FVector2D);
 			if (lua_isnumber(L, 2)) {
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = (*self * Scale);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self * Scale));
 				return 1;
 			}
 			if (LuaObject::matchType(L, 2, "FVector2D")) {
 				auto V = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector2D();
-				*ret = (*self * VRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self * VRef));
 				return 1;
 			}
 			luaL_error(L, "FVector2D operator__mul error, arg=%d", lua_typename(L, 2));
@@ -5415,17 +5129,13 @@ namespace NS_SLUA {
 			CheckSelf(FVector2D);
 			if (lua_isnumber(L, 2)) {
 				auto Scale = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = (*self / Scale);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self / Scale));
 				return 1;
 			}
 			if (LuaObject::matchType(L, 2, "FVector2D")) {
 				auto V = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& VRef = *V;
-				auto ret = __newFVector2D();
-				*ret = (*self / VRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", (*self / VRef));
 				return 1;
 			}
 			luaL_error(L, "FVector2D operator__div error, arg=%d", lua_typename(L, 2));
@@ -5595,9 +5305,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector2D);
 				auto AngleDeg = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = self->GetRotated(AngleDeg);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetRotated(AngleDeg));
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::GetRotated error, argc=%d", argc);
@@ -5609,9 +5317,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FVector2D);
 				auto Tolerance = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFVector2D();
-				*ret = self->GetSafeNormal(Tolerance);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetSafeNormal(Tolerance));
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::GetSafeNormal error, argc=%d", argc);
@@ -5675,9 +5381,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector2D);
-				auto ret = __newFVector2D();
-				*ret = self->RoundToVector();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->RoundToVector());
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::RoundToVector error, argc=%d", argc);
@@ -5690,9 +5394,7 @@ namespace NS_SLUA {
 				CheckSelf(FVector2D);
 				auto MinAxisVal = LuaObject::checkValue<float>(L, 2);
 				auto MaxAxisVal = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFVector2D();
-				*ret = self->ClampAxes(MinAxisVal, MaxAxisVal);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->ClampAxes(MinAxisVal, MaxAxisVal));
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::ClampAxes error, argc=%d", argc);
@@ -5703,9 +5405,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector2D);
-				auto ret = __newFVector2D();
-				*ret = self->GetSignVector();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetSignVector());
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::GetSignVector error, argc=%d", argc);
@@ -5716,9 +5416,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector2D);
-				auto ret = __newFVector2D();
-				*ret = self->GetAbs();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetAbs());
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::GetAbs error, argc=%d", argc);
@@ -5777,9 +5475,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FVector2D);
-				auto ret = __newFVector();
-				*ret = self->SphericalToUnitCartesian();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->SphericalToUnitCartesian());
 				return 1;
 			}
 			luaL_error(L, "call FVector2D::SphericalToUnitCartesian error, argc=%d", argc);
@@ -5849,6 +5545,7 @@ namespace NS_SLUA {
 		static void bind(lua_State* L) {
 			AutoStack autoStack(L);
 			LuaObject::newType(L, "FVector2D");
+			MathInPlaceWrapper<FVector2D>::bind(L);
 			LuaObject::addOperator(L, "__add", __add);
 			LuaObject::addOperator(L, "__sub", __sub);
 			LuaObject::addOperator(L, "__mul", __mul);
@@ -5990,9 +5687,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRandomStream);
-				auto ret = __newFVector();
-				*ret = self->GetUnitVector();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->GetUnitVector());
 				return 1;
 			}
 			luaL_error(L, "call FRandomStream::GetUnitVector error, argc=%d", argc);
@@ -6068,9 +5763,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FRandomStream);
-				auto ret = __newFVector();
-				*ret = self->VRand();
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->VRand());
 				return 1;
 			}
 			luaL_error(L, "call FRandomStream::VRand error, argc=%d", argc);
@@ -6084,9 +5777,7 @@ namespace NS_SLUA {
 				auto Dir = LuaObject::checkValue<FVector*>(L, 2);
 				auto& DirRef = *Dir;
 				auto ConeHalfAngleRad = LuaObject::checkValue<float>(L, 3);
-				auto ret = __newFVector();
-				*ret = self->VRandCone(DirRef, ConeHalfAngleRad);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->VRandCone(DirRef, ConeHalfAngleRad));
 				return 1;
 			}
 			if (argc == 4) {
@@ -6095,9 +5786,7 @@ namespace NS_SLUA {
 				auto& DirRef = *Dir;
 				auto HorizontalConeHalfAngleRad = LuaObject::checkValue<float>(L, 3);
 				auto VerticalConeHalfAngleRad = LuaObject::checkValue<float>(L, 4);
-				auto ret = __newFVector();
-				*ret = self->VRandCone(DirRef, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad);
-				LuaObject::push<FVector>(L, "FVector", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector>(L, "FVector", self->VRandCone(DirRef, HorizontalConeHalfAngleRad, VerticalConeHalfAngleRad));
 				return 1;
 			}
 			luaL_error(L, "call FRandomStream::VRandCone error, argc=%d", argc);
@@ -6333,15 +6022,13 @@ namespace NS_SLUA {
 		static int __ctor(lua_State* L) {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
-				auto self = new FBox2D();
-				LuaObject::push<FBox2D>(L, "FBox2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", FBox2D());
 				return 1;
 			}
 			if (argc == 2) {
 				auto _a0 = LuaObject::checkValue<int>(L, 2);
 				auto _a0Val = (EForceInit)_a0;
-				auto self = new FBox2D(_a0Val);
-				LuaObject::push<FBox2D>(L, "FBox2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", FBox2D(_a0Val));
 				return 1;
 			}
 			if (argc == 3) {
@@ -6349,8 +6036,7 @@ namespace NS_SLUA {
 				auto& InMinRef = *InMin;
 				auto InMax = LuaObject::checkValue<FVector2D*>(L, 3);
 				auto& InMaxRef = *InMax;
-				auto self = new FBox2D(InMinRef, InMaxRef);
-				LuaObject::push<FBox2D>(L, "FBox2D", self, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", FBox2D(InMinRef, InMaxRef));
 				return 1;
 			}
 			luaL_error(L, "call FBox2D() error, argc=%d", argc);
@@ -6382,17 +6068,13 @@ namespace NS_SLUA {
 			if (LuaObject::matchType(L, 2, "FBox2D")) {
 				auto Other = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFBox2D();
-				*ret = (*self + OtherRef);
-				LuaObject::push<FBox2D>(L, "FBox2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", (*self + OtherRef));
 				return 1;
 			}
 			if (LuaObject::matchType(L, 2, "FBox2D")) {
 				auto Other = LuaObject::checkValue<FBox2D*>(L, 2);
 				auto& OtherRef = *Other;
-				auto ret = __newFBox2D();
-				*ret = (*self + OtherRef);
-				LuaObject::push<FBox2D>(L, "FBox2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", (*self + OtherRef));
 				return 1;
 			}
 			luaL_error(L, "FBox2D operator__add error, arg=%d", lua_typename(L, 2));
@@ -6466,9 +6148,7 @@ namespace NS_SLUA {
 			if (argc == 2) {
 				CheckSelf(FBox2D);
 				auto W = LuaObject::checkValue<float>(L, 2);
-				auto ret = __newFBox2D();
-				*ret = self->ExpandBy(W);
-				LuaObject::push<FBox2D>(L, "FBox2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", self->ExpandBy(W));
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::ExpandBy error, argc=%d", argc);
@@ -6491,9 +6171,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FBox2D);
-				auto ret = __newFVector2D();
-				*ret = self->GetCenter();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetCenter());
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::GetCenter error, argc=%d", argc);
@@ -6523,9 +6201,7 @@ namespace NS_SLUA {
 				CheckSelf(FBox2D);
 				auto Point = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& PointRef = *Point;
-				auto ret = __newFVector2D();
-				*ret = self->GetClosestPointTo(PointRef);
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetClosestPointTo(PointRef));
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::GetClosestPointTo error, argc=%d", argc);
@@ -6536,9 +6212,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FBox2D);
-				auto ret = __newFVector2D();
-				*ret = self->GetExtent();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetExtent());
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::GetExtent error, argc=%d", argc);
@@ -6549,9 +6223,7 @@ namespace NS_SLUA {
 			auto argc = lua_gettop(L);
 			if (argc == 1) {
 				CheckSelf(FBox2D);
-				auto ret = __newFVector2D();
-				*ret = self->GetSize();
-				LuaObject::push<FVector2D>(L, "FVector2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FVector2D>(L, "FVector2D", self->GetSize());
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::GetSize error, argc=%d", argc);
@@ -6603,9 +6275,7 @@ namespace NS_SLUA {
 				CheckSelf(FBox2D);
 				auto Offset = LuaObject::checkValue<FVector2D*>(L, 2);
 				auto& OffsetRef = *Offset;
-				auto ret = __newFBox2D();
-				*ret = self->ShiftBy(OffsetRef);
-				LuaObject::push<FBox2D>(L, "FBox2D", ret, UD_AUTOGC);
+				LuaObject::pushValue<FBox2D>(L, "FBox2D", self->ShiftBy(OffsetRef));
 				return 1;
 			}
 			luaL_error(L, "call FBox2D::ShiftBy error, argc=%d", argc);
@@ -49,6 +49,8 @@ namespace NS_SLUA {
 		RegMetaMethod(L, loadObject);
 		RegMetaMethod(L, threadGC);
 		RegMetaMethod(L, isValid);
+		RegMetaMethod(L, objectCacheStats);
+		RegMetaMethod(L, gcStats);
         lua_setglobal(L,"slua");
     }
 
@@ -103,10 +105,13 @@ namespace NS_SLUA {
 		if (strcmp(flag, "on") == 0) {
 			state->enableMultiThreadGC = true;
 			lua_gc(L, LUA_GCSTOP, 0);
+			lua_gc(L, LUA_GCDEFERFREE, 1);
 		}
 		else if (strcmp(flag, "off") == 0) {
 			state->enableMultiThreadGC = false;
 			lua_gc(L, LUA_GCRESTART, 0);
+			lua_gc(L, LUA_GCDEFERFREE, 0);
+			// garbage swept before is still freed by Tick
 		}
 		return 0;
 	}
@@ -214,6 +219,11 @@ namespace NS_SLUA {
 		bool isValid = !(gud->flag & UD_HADFREE);
 		if(!isValid)
 			return LuaObject::push(L, isValid);
+		// handle of deleted object is stale, checkUD would raise error on it
+		if ((gud->flag & UD_OBJHANDLE) && !LuaObject::isObjectHandleValid(gud)) {
+			gud->flag |= UD_HADFREE;
+			return LuaObject::push(L, false);
+		}
 		// if this ud is boxed UObject
 		if (gud->flag & UD_UOBJECT) {
 			UObject* obj = LuaObject::checkUD<UObject>(L, 1);
@@ -227,6 +237,20 @@ namespace NS_SLUA {
 		return LuaObject::push(L, isValid);
 	}
 
+	int SluaUtil::objectCacheStats(lua_State* L)
+	{
+		auto& cache = LuaState::get(L)->getObjectCache();
+		lua_pushinteger(L, cache.num());
+		lua_pushinteger(L, (lua_Integer)cache.lookups());
+		lua_pushinteger(L, (lua_Integer)cache.hits());
+		return 3;
+	}
+
+	int SluaUtil::gcStats(lua_State* L)
+	{
+		return LuaState::get(L)->getGCScheduler().push(L);
+	}
+
 #if WITH_EDITOR
 #define CheckState(state) if(!state) { \
 	Log::Error("Not find any state is available"); \
@@ -50,6 +50,12 @@ namespace NS_SLUA {
 		// return whether an userdata is valid?
     	// ǷЧ
 		static int isValid(lua_State* L);
+		// return size, lookups and hits of object cache
+		// 󻺴ͳ
+		static int objectCacheStats(lua_State* L);
+		// return table of decisions made by gc scheduler
+		// GCͳ
+		static int gcStats(lua_State* L);
     };
 
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and limitations under the License.
 
 #include "slua_unreal.h"
+#include "LuaObject.h"
 
 #define LOCTEXT_NAMESPACE "Fslua_unrealModule"
 
@@ -25,7 +26,7 @@ void Fslua_unrealModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+	NS_SLUA::LuaStruct::releaseBufferPool();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -43,7 +43,7 @@ public:	\
 	void superTick() override { \
 		Super::Tick(deltaTime); \
 	} \
-	NS_SLUA::LuaVar getSelfTable() const { \
+	const NS_SLUA::LuaVar& getSelfTable() const { \
 		return luaSelfTable; \
 	} \
 
@@ -228,7 +228,7 @@ public:
 		if (!GetClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
 			ReceiveTick(tickTmpArgs.deltaTime);
 	}
-	NS_SLUA::LuaVar getSelfTable() const {
+	const NS_SLUA::LuaVar& getSelfTable() const {
 		return luaSelfTable;
 	}
 public:
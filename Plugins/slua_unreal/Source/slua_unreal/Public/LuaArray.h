@@ -83,6 +83,12 @@ namespace NS_SLUA {
         static int Clear(lua_State* L);
 		static int Pairs(lua_State* L);
 		static int Enumerable(lua_State* L);
+		// lua tableת
+		static int ToTable(lua_State* L);
+		static int FromTable(lua_State* L);
+		static int Append(lua_State* L);
+		// 㿽ֵͼ
+		static int View(lua_State* L);
 
     private:
         UProperty* inner;
@@ -100,6 +106,13 @@ namespace NS_SLUA {
         int num() const;
         void constructItems(int index,int count);
         void destructItems(int index,int count);      
+        // append items from sequence of lua table at index t
+        void appendTable(lua_State* L, int t);
+
+		// inner type which could be copied from/to lua directly, without pusher/checker
+		// ֱӿԪ
+		enum class PODKind : uint8 { None, Int, Float, Double, Bool, Byte };
+		static PODKind getPODKind(UProperty* p);
 
         static int setupMT(lua_State* L);
         static int gc(lua_State* L);
@@ -112,5 +125,21 @@ namespace NS_SLUA {
 			static int gc(lua_State* L);
 			~Enumerator();
 		};
+
+		// typed view over memory of POD array, element is read/written in place by 0-based index,
+		// index is checked against live Num() of array
+		// ֵͼ,ֱӶдڴ
+		struct BufferView {
+			LuaArray* arr = nullptr;
+			// hold referrence of LuaArray, keep owner object alive
+			class LuaVar* holder = nullptr;
+			PODKind kind = PODKind::None;
+			static int __index(lua_State* L);
+			static int __newindex(lua_State* L);
+			static int __len(lua_State* L);
+			static int setupMT(lua_State* L);
+			static int gc(lua_State* L);
+			~BufferView();
+		};
     };
 }
\ No newline at end of file
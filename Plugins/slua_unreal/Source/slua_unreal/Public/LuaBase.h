@@ -151,6 +151,32 @@ namespace NS_SLUA {
 		void bindOverrideFunc(UObject* obj);
 		DECLARE_FUNCTION(luaOverrideFunc);
 
+		// slot of each blueprint event of a class, function overridden by child class shares slot of same name
+		// ÿͼ¼Ĳλ
+		struct OverrideSlots {
+			TMap<UFunction*, int32> funcSlots;
+			TMap<FString, int32> nameSlots;
+			// utf8 name indexed by slot, used to check field of self table
+			TArray<TArray<ANSICHAR>> slotNames;
+			// never reused, keys lua table of slot names in each state
+			int32 id;
+			// unique id of functions marked overridden through these slots
+			TSet<int32> markedFuncs;
+		};
+		static TSharedPtr<OverrideSlots> getOverrideSlots(UClass* cls);
+		// fetch or create name table of overrideSlots in state of self table
+		void bindOverrideNames();
+		// lua function overriding func, resolved by bindOverrideFunc, invalid if not overridden,
+		// nullptr if func isn't a blueprint event of class,
+		// cached function is checked against field of self table on each call,
+		// since assigning an existing field is a raw set which doesn't reach __newindex,
+		// field name is taken from anchored name table by slot, so no string is hashed,
+		// returned without copy, pointer to the slot is valid until bindOverrideFunc,
+		// slot may be reassigned while its function is being called
+		LuaVar* getOverrideFunc(UFunction* func);
+		// field assigned by __newindex replaces cached function and hooks event
+		void updateOverrideFunc(const char* name, lua_State* L, int p);
+
 		// super Ԫ
 		static int supermt(lua_State* L);
 		// rpc Ԫ
@@ -184,6 +210,13 @@ namespace NS_SLUA {
 
 		LuaVar luaSelfTable;
 		LuaVar tickFunction;
+		// lua functions indexed by override slot of class
+		// λluaغ
+		TSharedPtr<OverrideSlots> overrideSlots;
+		TArray<LuaVar> overrideFuncs;
+		// lua strings of slot names indexed by slot+1, shared by instances of class in same state
+		// λַ,ÿεôַ
+		LuaVar overrideNames;
 		FWeakObjectPtr context;
 		LuaVar metaTable;
 		IndexFlag indexFlag = IF_NONE;
@@ -209,5 +242,5 @@ public:
 	static int push(NS_SLUA::lua_State* L, ILuaTableObjectInterface* luaTableObj);
 
 	// self
-	virtual NS_SLUA::LuaVar getSelfTable() const = 0;
+	virtual const NS_SLUA::LuaVar& getSelfTable() const = 0;
 };
\ No newline at end of file
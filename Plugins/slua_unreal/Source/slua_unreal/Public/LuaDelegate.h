@@ -20,6 +20,12 @@
 
 namespace NS_SLUA {
     class LuaVar;
+
+    // lua function added to multicast delegate, handle is returned to lua for removing it
+    struct LuaDelegateListener {
+        LuaVar* func;
+        void* handle;
+    };
 }
 
 UCLASS()
@@ -40,6 +46,17 @@ public:
 	// ͷ
 	void dispose();
 
+	// all lua functions added to a multicast delegate in a lua state share one ULuaDelegate,
+	// parameters are pushed once and listeners are called in order of adding
+	// ಥһULuaDelegate,ֻѹջһ,˳
+	void* addListener(NS_SLUA::lua_State *L, int p, UFunction *func);
+	// return false if handle isn't a listener of it
+	bool removeListener(void* handle);
+	bool hasListener() const;
+	bool isDispatcherOf(int stateIndex) const {
+		return dispatchState == stateIndex && ufunction != nullptr;
+	}
+
 #if WITH_EDITOR
 	void setPropName(FString name) {
 		pName = name;
@@ -55,6 +72,13 @@ private:
     NS_SLUA::LuaVar* luafunction;
 	// 亯
 	UFunction* ufunction;
+	TArray<NS_SLUA::LuaDelegateListener> listeners;
+	// index of lua state of listeners, -1 if it isn't a multicast dispatcher
+	int dispatchState;
+	// removed listeners are kept as null until outermost broadcast ends
+	int dispatchDepth;
+
+	void dispatch(uint8* parms);
 #if WITH_EDITOR
 	FString pName;
 #endif
@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "lua/lua.hpp"
+
+namespace NS_SLUA {
+
+	// run lua incremental gc in Tick of LuaState within a time budget of frame,
+	// step size is adapted by measured step cost, pause and stepmul are adapted by heap size,
+	// work of hitching frame is deferred to frames with slack
+	// ֡ʱԤluaGC
+	class SLUA_UNREAL_API LuaGCScheduler {
+	public:
+		struct Config {
+			// milliseconds of gc work per frame
+			float budgetMs = 1.0f;
+			// heap size in KB, gc is more aggressive above it, 0 means no target
+			int32 targetHeapKB = 0;
+			// frame longer than average frame time multiplied by it is a hitch, its work is deferred
+			float hitchRatio = 1.5f;
+		};
+
+		struct Stats {
+			uint64 frames = 0;
+			uint64 steps = 0;
+			uint64 cycles = 0;
+			// frames with at most one step since heap isn't growing
+			uint64 idleFrames = 0;
+			// frames whose work is deferred because of hitch
+			uint64 deferredFrames = 0;
+			double lastFrameMs = 0;
+			double maxStepMs = 0;
+			// deferred work in milliseconds
+			double debtMs = 0;
+			int32 stepKB = 0;
+			int32 heapKB = 0;
+			int32 pause = 0;
+			int32 stepmul = 0;
+		};
+
+		LuaGCScheduler();
+
+		// config used by LuaState with the name when it's inited
+		// LuaState
+		static void setStateConfig(const FString& stateName, const Config& config);
+		static Config getStateConfig(const FString& stateName);
+
+		void setConfig(const Config& config);
+		const Config& getConfig() const { return config; }
+		const Stats& getStats() const { return stats; }
+		void reset();
+
+		// called every frame by LuaState::Tick
+		void tick(lua_State* L, float dtime);
+
+		int push(lua_State* L) const;
+
+	private:
+		Config config;
+		Stats stats;
+		double avgFrameTime;
+		int32 lastHeapKB;
+		// 0 for default pause and stepmul, 1 for aggressive
+		int32 level;
+
+		void adjustParams(lua_State* L, int32 heapKB);
+		void step(lua_State* L, double budgetMs);
+		// run a step of stepKB and adapt stepKB by its cost, return true if a cycle is finished
+		bool stepOnce(lua_State* L, double* cost = nullptr);
+	};
+}
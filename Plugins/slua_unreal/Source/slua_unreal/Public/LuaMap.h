@@ -108,10 +108,16 @@ namespace NS_SLUA {
         static int Add(lua_State* L);
         static int Remove(lua_State* L);
         static int Clear(lua_State* L);
+		static int GetMany(lua_State* L);
+		static int ToTable(lua_State* L);
 		static int Pairs(lua_State* L);
 		static int Enumerable(lua_State* L);
 
 	private:
+		// key type which could be hashed from lua value directly, without temporary key
+		// 可以直接用lua值计算hash的key类型
+		enum class KeyKind : uint8 { None, Int, Int64, Name, Str, Object };
+
 		FScriptMap* map;
 		UProperty* keyProp;
 		UProperty* valueProp;
@@ -120,7 +126,9 @@ namespace NS_SLUA {
 		FScriptMapHelper helper;
 		bool createdByBp;
 		bool shouldFree;
+		KeyKind keyKind;
 
+		static KeyKind getKeyKind(UProperty* p);
 		static int setupMT(lua_State* L);
 		static int gc(lua_State* L);
 
@@ -131,7 +139,11 @@ namespace NS_SLUA {
 		void emptyValues(int32 Slack = 0);
 		void destructItems(int32 Index, int32 Count);
 		void destructItems(uint8* PairPtr, uint32 Stride, int32 Index, int32 Count, bool bDestroyKeys, bool bDestroyValues);
-		bool removePair(const void* KeyPtr);
+		// find value of key at index p of lua stack, return nullptr if not found
+		uint8* findValue(lua_State* L, int p);
+		template<typename T>
+		uint8* findValueByKey(const T& key);
+		void removeValue(uint8* valuePtr);
 		void removeAt(int32 Index, int32 Count = 1);
 
 		struct Enumerator {
@@ -21,6 +21,7 @@
 #include "SluaUtil.h"
 #include "LuaArray.h"
 #include "LuaMap.h"
+#include "LuaSet.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #ifndef SLUA_CPPINST
@@ -83,22 +84,36 @@ namespace NS_SLUA {
     };
 
 	// LuaʹUE4ṹ
-    struct SLUA_UNREAL_API LuaStruct : public FGCObject {
+	// it isn't a FGCObject, LuaState references all structs pushed to lua in one pass
+	// LuaStateͳһ
+    struct SLUA_UNREAL_API LuaStruct {
         uint8* buf;
         uint32 size;
         UScriptStruct* uss;
-
-        LuaStruct(uint8* buf,uint32 size,UScriptStruct* uss);
+		// buf references struct member of an UObject and isn't owned
+		// UObjectĽṹԱ,buf
+		bool isRef;
+		// index in struct list of LuaState
+		int32 index;
+
+		// buf should be allocated by allocBuffer
+        LuaStruct(uint8* buf,uint32 size,UScriptStruct* uss,bool isRef=false);
         ~LuaStruct();
 
-		virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+		// copy referenced struct into own buf, called before referenced memory becomes unreachable
+		// õĽṹ
+		void detach();
 
-#if (ENGINE_MINOR_VERSION>=20) && (ENGINE_MAJOR_VERSION>=4)
-		virtual FString GetReferencerName() const override
-		{
-			return "LuaStruct";
-		}
-#endif
+		void AddReferencedObjects(FReferenceCollector& Collector);
+
+		// buffer is pooled by size class, only called in game thread
+		// ṹڴ
+		static uint8* allocBuffer(uint32 size);
+		static void freeBuffer(uint8* buf, uint32 size);
+		// free pooled buffers, called when state is closed and module is shut down,
+		// pool isn't freed by static destructor which may run after allocator is gone
+		// ״̬رպģжʱͷڴ
+		static void releaseBufferPool();
     };
 
 	// FLAG	
@@ -145,6 +160,12 @@ namespace NS_SLUA {
 	#define UD_WEAKUPTR 1<<8 // flag it's a weak UObject ptr
 	// 
 	#define UD_REFERENCE 1<<9
+	// value stored in userdata block, ud points to it, see LuaObject::pushValue
+	// ֱֵӴuserdataڴ
+	#define UD_INLINE 1<<10
+	// userdata is ObjectHandleUD, validated by serial number in GUObjectArray when it's used
+	// ʹö,ʱУк
+	#define UD_OBJHANDLE 1<<11
 
 	struct UDBase {
 		uint32 flag;
@@ -157,6 +178,14 @@ namespace NS_SLUA {
 		void* ud;
 	};
 
+	// userdata of UObject when object handle is enabled, see LuaState::enableObjectHandle,
+	// index and serial are used to detect deleted object without delete listener
+	// UObject,к
+	struct ObjectHandleUD : public GenericUserData {
+		int32 index;
+		int32 serial;
+	};
+
 	template<class T>
 	struct UserData : public UDBase {
 		// ģ͵ĴСҪָС
@@ -164,8 +193,20 @@ namespace NS_SLUA {
 		T ud; 
 	};
 
+	// small POD value type which is stored in userdata block when pushed by value,
+	// use DefInlineValueType to opt in
+	// 洢ֵ
+	template<typename T>
+	struct InlineValueType {
+		enum { value = false };
+	};
+
+	#define DefInlineValueType(T) \
+		template<> struct InlineValueType<T> { enum { value = true }; }
+
     DefTypeName(LuaArray);
     DefTypeName(LuaMap);
+    DefTypeName(LuaSet);
 
     template<typename T>
     struct LuaOwnedPtr {
@@ -222,12 +263,57 @@ namespace NS_SLUA {
 		}
 	};
 
+	// member of UClass resolved by instance __index/__newindex
+	// Ա,UProperty,UFunctionչ
+	struct CacheMember {
+		enum Kind : uint8 {
+			Property,
+			Function,
+			ExtensionMethod,
+			ExtensionProperty,
+		};
+		Kind kind;
+		// UProperty or UFunction, may be regenerated by blueprint compile
+		TWeakObjectPtr<UField> field;
+		// extension method or getter of extension property
+		lua_CFunction func;
+	};
+
+	// parameter memory of an UFunction call, replace FStructOnScope on hot path
+	// small params use inline buffer on stack, big params fallback to heap,
+	// initialize/destroy are skipped if flags of call plan show all params are plain old data
+	// UFunctionõĲڴ,Сʹջڴ,POD
+	class SLUA_UNREAL_API FuncParamsScope {
+	public:
+		// always initialize and destroy params
+		explicit FuncParamsScope(UFunction* func);
+		// needInit and needDestroy are computed from property flags, see FuncCallPlan
+		FuncParamsScope(UFunction* func, bool needInit, bool needDestroy);
+		~FuncParamsScope();
+
+		uint8* get() const { return params; }
+
+	private:
+		FuncParamsScope(const FuncParamsScope&) = delete;
+		FuncParamsScope& operator=(const FuncParamsScope&) = delete;
+
+		// params bigger than this will be allocated from heap
+		enum { InlineSize = 256, InlineAlignment = 16 };
+
+		UFunction* func;
+		uint8* params;
+		bool needDestroy;
+		TAlignedBytes<InlineSize, InlineAlignment> inlineBuffer;
+	};
+
 	// ؼĲ
     class SLUA_UNREAL_API LuaObject
     {
     private:
 		// checkfreeǵĺĺ
-#define CHECK_UD_VALID(ptr) if (ptr && ptr->flag&UD_HADFREE) { \
+#define CHECK_UD_VALID(ptr) if (ptr && (ptr->flag&(UD_OBJHANDLE|UD_HADFREE)) == UD_OBJHANDLE && !isObjectHandleValid(ptr)) \
+		ptr->flag |= UD_HADFREE; \
+	if (ptr && ptr->flag&UD_HADFREE) { \
 		if (checkfree) \
 			luaL_error(L, "arg %d had been freed(%p), can't be used", lua_absindex(L, p), ptr->ud); \
 		else \
@@ -251,7 +337,7 @@ namespace NS_SLUA {
         template<typename T>
         static typename std::enable_if<std::is_base_of<UObject,T>::value && !std::is_same<UObject,T>::value, T*>::type 
 		testudata(lua_State* L,int p, bool checkfree=true) {
-            UserData<UObject*>* ptr = (UserData<UObject*>*)luaL_testudata(L,p,"UObject");
+            UserData<UObject*>* ptr = (UserData<UObject*>*)testUserdata(L,p,"UObject");
 			CHECK_UD_VALID(ptr);
 			T* t = nullptr;
 			// if it's a weak UObject, rawget it
@@ -296,7 +382,7 @@ namespace NS_SLUA {
         template<typename T>
         static typename std::enable_if<std::is_same<UObject,T>::value, T*>::type 
 		testudata(lua_State* L,int p, bool checkfree=true) {
-            auto ptr = (UserData<T*>*)luaL_testudata(L,p,"UObject");
+            auto ptr = (UserData<T*>*)testUserdata(L,p,"UObject");
 			CHECK_UD_VALID(ptr);
 			if (!ptr) return maybeAnUDTable<T>(L, p, checkfree);
 			// if it's a weak UObject ptr
@@ -370,11 +456,51 @@ namespace NS_SLUA {
         static CheckPropertyFunction getChecker(UProperty* cls);
         static PushPropertyFunction getPusher(UClass* cls);
 
+		// marshalling plan of an UFunction, compiled once and cached by LuaState,
+		// call of UFunction loops over params without reflection iteration or checker/pusher lookup
+		// UFunctionüƻ,Ԥȼƫƺchecker/pusher
+		struct FuncCallPlan {
+			enum ParamFlag : uint8 {
+				// filled from lua stack
+				PF_Input = 1 << 0,
+				// CPF_OutParm, accept nil as input
+				PF_OutParm = 1 << 1,
+				// real out param, pushed to lua after call
+				PF_Output = 1 << 2,
+				PF_Return = 1 << 3,
+				PF_LatentInfo = 1 << 4,
+			};
+			struct Param {
+				UProperty* prop;
+				int32 offset;
+				CheckPropertyFunction checker;
+				PushPropertyFunction pusher;
+				uint8 flags;
+			};
+			TWeakObjectPtr<UFunction> func;
+			// params in declaration order
+			TArray<Param> params;
+			// index of return value in params, INDEX_NONE if hasn't
+			int32 returnIndex;
+			bool isLatent;
+			// any property of func isn't CPF_ZeroConstructor, include locals of script function
+			bool needInit;
+			// any property of func has destructor
+			bool needDestroy;
+		};
+		// get call plan of func, compile it if not cached
+		// ȡüƻ,ûеĻ벢
+		static const FuncCallPlan* getCallPlan(lua_State* L, UFunction* func);
+
     	// tn		=>	
     	// noprefix	=>	ǰ׺
 		// Ƿƥ
     	static bool matchType(lua_State* L, int p, const char* tn, bool noprefix=false);
 
+		// same as luaL_testudata, but UObject userdata with class metatable is also accepted as "UObject"
+		// luaL_testudataͬ,ͬʱ֧ʹԪUObject
+		static void* testUserdata(lua_State* L, int p, const char* tn);
+
     	// class__indexԪ
 		static int classIndex(lua_State* L);
     	// class__newindexԪ
@@ -399,6 +525,10 @@ namespace NS_SLUA {
     	static void fillParam(lua_State* L, int i, UFunction* func, uint8* params);
 		// ֵѹջ
     	static int returnValue(lua_State* L, UFunction* func, uint8* params);
+		// same as above, use precompiled call plan
+		// ʹõüƻʹֵ
+		static void fillParam(lua_State* L, int i, const FuncCallPlan* plan, uint8* params);
+		static int returnValue(lua_State* L, const FuncCallPlan* plan, uint8* params);
 
     	// UFunction
 		static void callUFunction(lua_State* L, UObject* obj, UFunction* func, uint8* params);
@@ -584,7 +714,7 @@ namespace NS_SLUA {
     	// UObject
         template<class T>
         static UObject* checkUObject(lua_State* L,int p) {
-            UserData<UObject*>* ud = reinterpret_cast<UserData<UObject*>*>(luaL_checkudata(L, p,"UObject"));
+            UserData<UObject*>* ud = reinterpret_cast<UserData<UObject*>*>(testUserdata(L, p,"UObject"));
             if(!ud) luaL_error(L, "checkValue error at %d",p);
             return Cast<T>(ud->ud);
         }
@@ -615,7 +745,7 @@ namespace NS_SLUA {
 				// UScriptStructµMinAlignmentΪ1
 				uint32 size = uss->GetStructureSize() ? uss->GetStructureSize() : 1;
 				ensure(size == sizeof(T));
-				uint8* buf = (uint8*)FMemory::Malloc(size);
+				uint8* buf = LuaStruct::allocBuffer(size);
 				uss->InitializeStruct(buf);
 				uss->CopyScriptStruct(buf, v);
 				cacheObj(L, void_cast(v));
@@ -630,6 +760,37 @@ namespace NS_SLUA {
             return 1;
 		}
 
+		// push a copy of v, inline value type is constructed in userdata block directly,
+		// so it needs no heap allocation, no cache and no delete in __gc
+		// ֵѹջ,ͲҪڴ
+		template<class T>
+		static typename std::enable_if<InlineValueType<T>::value, int>::type
+		pushValue(lua_State* L, const char* tn, const T& v) {
+			static_assert(TIsTriviallyDestructible<T>::Value, "Inline value type should be trivially destructible");
+			luaL_getmetatable(L, tn);
+			if (lua_isnil(L, -1)) {
+				lua_pop(L, 1);
+				return push<T>(L, tn, new T(v), UD_AUTOGC);
+			}
+			// value follows header, lua only guarantees alignment of header
+			auto ud = lua_newuserdata(L, sizeof(UserData<T*>) + sizeof(T) + alignof(T) - 1);
+			if (!ud) luaL_error(L, "out of memory to new ud");
+			auto udptr = reinterpret_cast<UserData<T*>*>(ud);
+			udptr->parent = nullptr;
+			udptr->ud = new (Align(reinterpret_cast<uint8*>(udptr + 1), alignof(T))) T(v);
+			udptr->flag = UD_INLINE;
+			lua_pushvalue(L, -2);
+			lua_setmetatable(L, -2);
+			lua_remove(L, -2); // remove metatable of tn
+			return 1;
+		}
+
+		template<class T>
+		static typename std::enable_if<!InlineValueType<T>::value, int>::type
+		pushValue(lua_State* L, const char* tn, const T& v) {
+			return push<T>(L, tn, new T(v), UD_AUTOGC);
+		}
+
     	// Ƴ
 		static void releaseLink(lua_State* L, void* prop);
 		// 
@@ -743,10 +904,11 @@ namespace NS_SLUA {
     	// push GCObject ,GCǷ
         template<typename T>
         static int pushGCObject(lua_State* L,T obj,const char* tn,lua_CFunction setupmt,lua_CFunction gc,bool ref) {
-            if(getFromCache(L,obj,tn)) return 1;
+            // address of a deleted object may be reused, stale handle is replaced
+            if(getFromCache(L,obj,tn) && !popStaleObjectHandle(L)) return 1;
             lua_pushcclosure(L,gc,0);
             int f = lua_gettop(L);
-            int r = pushType<T>(L,obj,tn,setupmt,f);
+            int r = pushObjectType(L,obj,tn,setupmt,f);
             lua_remove(L,f); // remove wraped gc function
 			if (r) {
 				addRef(L, obj, lua_touserdata(L, -1), ref);
@@ -767,6 +929,11 @@ namespace NS_SLUA {
     	// self__indexԪ
 		static int setupMTSelfSearch(lua_State* L);
 
+		// push metatable generated for cls, with pre-bound property accessors and UFunction closures,
+		// super class's members are chained by __index, see LuaState::enableClassMetatable
+		// push clsӦԪ,Աͨ__index
+		static void pushClassMetatable(lua_State* L, UClass* cls);
+
     	// push Class
         static int pushClass(lua_State* L,UClass* cls);
 		// push Struct
@@ -783,6 +950,8 @@ namespace NS_SLUA {
 		static int push(lua_State* L, FWeakObjectPtr ptr);
 		static int push(lua_State* L, FScriptDelegate* obj);
 		static int push(lua_State* L, LuaStruct* ls);
+		// push struct member of obj without copy
+		static int pushStructReference(lua_State* L, UStructProperty* p, UObject* obj);
 		static int push(lua_State* L, double v);
         static int push(lua_State* L, int64 v);
         static int push(lua_State* L, uint64 v);
@@ -897,6 +1066,12 @@ namespace NS_SLUA {
 			return LuaMap::push(L, v);
 		}
 
+		// TSet
+		template<typename T>
+		static int push(lua_State* L, const TSet<T>& v) {
+			return LuaSet::push(L, v);
+		}
+
 		// static int push(lua_State* L, FScriptArray* array);
 
     	// push nil
@@ -920,12 +1095,22 @@ namespace NS_SLUA {
 		// ӻ
     	static void cacheProperty(lua_State* L, UClass* cls, const char* pname, UProperty* property);
 
+		// find member of cls by name at index p, name should be a short string interned by lua
+		// return nullptr if name isn't interned or not cached
+		// ͨluaڻַĵַѯԱ,ַת
+		static const CacheMember* findCacheMember(lua_State* L, UClass* cls, int p);
+		// ӻԱ
+		static void cacheMember(lua_State* L, UClass* cls, int p, const CacheMember& member);
+
     	// ѯ
         static bool getFromCache(lua_State* L, void* obj, const char* tn, bool check = true);
 		// ӻ
     	static void cacheObj(lua_State* L, void* obj);
     	// ɾ
 		static void removeFromCache(lua_State* L, void* obj);
+		// check ObjectHandleUD whether its object is still alive
+		// УǷЧ
+		static bool isObjectHandleValid(const void* ud);
 		static ULatentDelegate* getLatentDelegate(lua_State* L);
     	// LuaStructװĶ
 		static void deleteFGCObject(lua_State* L,FGCObject* obj);
@@ -952,6 +1137,15 @@ namespace NS_SLUA {
     	// RPC
 		static void callRpc(lua_State* L, UObject* obj, UFunction* func, uint8* params);
 
+		// push UObject with metatable of its class
+		static int pushObjectWithClassMT(lua_State* L, UObject* obj, bool ref);
+		// push userdata of UObject, it's an ObjectHandleUD if object handle is enabled
+		static int pushObjectType(lua_State* L, UObject* obj, const char* tn, lua_CFunction setupmt, int gc);
+		// pop userdata on top if it's a stale object handle
+		static bool popStaleObjectHandle(lua_State* L);
+		// release userdata with object handle at p when it's collected
+		static bool releaseObjectHandle(lua_State* L, int p);
+
     	// push 
         template<class T, bool F = IsUObject<T>::value>
         static int pushType(lua_State* L,T cls,const char* tn,lua_CFunction setupmt,int gc) {
@@ -0,0 +1,104 @@
+﻿// Tencent is pleased to support the open source community by making sluaunreal available.
+
+// Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+// Licensed under the BSD 3-Clause License (the "License"); 
+// you may not use this file except in compliance with the License. You may obtain a copy of the License at
+
+// https://opensource.org/licenses/BSD-3-Clause
+
+// Unless required by applicable law or agreed to in writing, 
+// software distributed under the License is distributed on an "AS IS" BASIS, 
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. 
+// See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "lua/lua.hpp"
+#include "UObject/UnrealType.h"
+#include "UObject/GCObject.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "PropertyUtil.h"
+
+namespace NS_SLUA {
+
+	class SLUA_UNREAL_API LuaSet : public FGCObject {
+
+	public:
+		static void reg(lua_State* L);
+		static int push(lua_State* L, UProperty* elementProp, const FScriptSet* buf);
+		// UObject持有
+		static int push(lua_State* L, USetProperty* prop, UObject* obj);
+		template<typename T>
+		static int push(lua_State* L, const TSet<T>& v) {
+			UProperty* elementProp = PropertyProto::createProperty(PropertyProto::get<T>());
+			return push(L, elementProp, reinterpret_cast<const FScriptSet*>(&v));
+		}
+
+		static void clone(FScriptSet* dest, UProperty* elementProp, const FScriptSet* src);
+
+		LuaSet(UProperty* elementProp, const FScriptSet* buf);
+		// UObject持有
+		LuaSet(USetProperty* prop, UObject* obj);
+		~LuaSet();
+
+		const FScriptSet* get() {
+			return set;
+		}
+
+		virtual void AddReferencedObjects( FReferenceCollector& Collector ) override;
+
+#if (ENGINE_MINOR_VERSION>=20) && (ENGINE_MAJOR_VERSION>=4)
+		virtual FString GetReferencerName() const override
+		{
+			return "LuaSet";
+		}
+#endif
+
+	protected:
+		static int __ctor(lua_State* L);
+		static int Num(lua_State* L);
+		static int Contains(lua_State* L);
+		static int Add(lua_State* L);
+		static int Remove(lua_State* L);
+		static int Clear(lua_State* L);
+		static int Pairs(lua_State* L);
+		static int Enumerable(lua_State* L);
+
+	private:
+		// element type which could be hashed from lua value directly, without temporary element
+		// 可以直接用lua值计算hash的元素类型
+		enum class ElementKind : uint8 { None, Int, Int64, Name, Str, Object };
+
+		FScriptSet* set;
+		UProperty* elementProp;
+		USetProperty* prop;
+		UObject* propObj;
+		FScriptSetHelper helper;
+		bool shouldFree;
+		ElementKind elementKind;
+
+		static ElementKind getElementKind(UProperty* p);
+		static int setupMT(lua_State* L);
+		static int gc(lua_State* L);
+
+		void clear();
+		int32 num() const;
+		// find index of element at index p of lua stack, return INDEX_NONE if not found
+		int32 findIndex(lua_State* L, int p);
+		template<typename T>
+		int32 findIndexByElement(const T& element);
+
+		struct Enumerator {
+			LuaSet* set = nullptr;
+			// hold referrence of LuaSet, avoid gc
+			class LuaVar* holder = nullptr;
+			int32 index = 0;
+			int32 num = 0;
+
+			static int gc(lua_State* L);
+			~Enumerator();
+		};
+
+	};
+	
+}
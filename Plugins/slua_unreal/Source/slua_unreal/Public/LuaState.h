@@ -21,6 +21,8 @@
 #include <atomic>
 #include "HAL/Runnable.h"
 #include "Tickable.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "LuaGCScheduler.h"
 
 #define SLUA_LUACODE "[sluacode]"
 #define SLUA_CPPINST "__cppinst"
@@ -31,6 +33,8 @@ class ULatentDelegate;
 
 namespace NS_SLUA {
 
+	class LuaPoolAllocator;
+
 	struct ScriptTimeoutEvent {
 		virtual void onTimeout() = 0;
 	};
@@ -197,12 +201,107 @@ namespace NS_SLUA {
     	// Tick
 		void setTickFunction(LuaVar func);
 
+		// if enabled, the first push of an UObject of each UClass builds a dedicated metatable
+		// with pre-bound property getter/setter and UFunction closures,
+		// UObject pushed before keep their metatable, it's disabled by default
+		// ,ÿUClassʹöԪ,ԺͷֱӲ
+		void enableClassMetatable(bool enable) {
+			classMetatableEnabled = enable;
+		}
+
+		// if enabled, reading struct member of UObject returns a LuaStruct referencing the member,
+		// writing its fields changes the UObject, it's copied when userdata of the UObject is collected,
+		// it's disabled by default, struct member is copied on every read
+		// ,ȡUObjectĽṹԱٿ
+		void enableStructReference(bool enable) {
+			structReferenceEnabled = enable;
+		}
+
+		// if enabled, userdata of UObject keeps index and serial number in GUObjectArray,
+		// deleted UObject is detected when its userdata is used instead of by delete listener,
+		// only UObject pushed with ref is held in objRefs, struct member is always copied,
+		// it should be called before init, it's disabled by default
+		// ,UObjectuserdataʹþУ,ټUObjectɾ
+		void enableObjectHandle(bool enable) {
+			if (!L) objectHandleEnabled = enable;
+		}
+
+		// if enabled, small blocks of lua are allocated from size-class pools of this state,
+		// it should be called before init, it's disabled by default
+		// ,luaСڴӸStateķּڴط
+		void enablePoolAllocator(bool enable) {
+			if (!L) poolAllocatorEnabled = enable;
+		}
+
+		// null if pool allocator isn't enabled
+		LuaPoolAllocator* getPoolAllocator() const {
+			return poolAllocator;
+		}
+
+		// time budget in seconds of lua gc step after engine gc if multi-thread gc is enabled,
+		// the step isn't run in reference collecting of engine gc
+		// ߳GCģʽ,GC֮luaGCʱԤ
+		void setGCStepBudget(double seconds) {
+			gcStepBudget = seconds;
+		}
+
+		// native cache from pointer pushed to lua to slot of a weak table which holds its userdata,
+		// slot is found by open addressing with linear probing, a miss doesn't touch lua,
+		// slot cleared by lua gc is treated as miss and removed
+		// ָ뵽userdataڲλĻ
+		struct ObjectCache {
+			struct Entry {
+				void* key;
+				int32 slot;
+			};
+
+			// return slot of key, 0 if not found
+			int32 find(void* key) const;
+			// return slot of key, add it if not found
+			int32 add(void* key);
+			// return slot of removed key, 0 if not found
+			int32 remove(void* key);
+			void clear();
+
+			int32 num() const { return count; }
+			uint64 lookups() const { return lookupCount; }
+			uint64 hits() const { return hitCount; }
+
+		private:
+			friend class LuaObject;
+			// size of entries is power of 2, empty entry has nullptr key
+			TArray<Entry> entries;
+			TArray<int32> freeSlots;
+			// 64 - log2(size of entries), home index is taken from high bits of hashed key
+			int32 shift = 64;
+			int32 count = 0;
+			int32 maxSlot = 0;
+			uint64 lookupCount = 0;
+			uint64 hitCount = 0;
+
+			int32 indexOf(void* key) const;
+			uint32 homeOf(void* key) const;
+			void grow();
+		};
+
+		const ObjectCache& getObjectCache() const {
+			return objCache;
+		}
+
+		// gc scheduler used in Tick if multi-thread gc isn't enabled,
+		// it takes config set by LuaGCScheduler::setStateConfig with name of this state when inited
+		// ֡ԤGC
+		LuaGCScheduler& getGCScheduler() {
+			return gcScheduler;
+		}
+
 		// add obj to ref, tell Engine don't collect this obj
     	// ӵ,ֹGC
 		void addRef(UObject* obj,void* ud,bool ref);
 		// unlink UObject, flag Object had been free, and remove from cache and objRefs
+		// if detach is true, Object is alive and struct referenced from it will be copied
     	// ȡ
-		void unlinkUObject(const UObject * Object);
+		void unlinkUObject(const UObject * Object, bool detach = false);
 
 		// if obj be deleted, call this function
     	// ɾʱ,ú => ̳FUObjectDeleteListener
@@ -255,6 +354,7 @@ namespace NS_SLUA {
 		friend class LuaScriptCallGuard;
         lua_State* L;
         int cacheObjRef;
+		ObjectCache objCache;
 		// init enums lua code
         int _pushErrorHandler(lua_State* L);
         static int _atPanic(lua_State* L);
@@ -264,6 +364,22 @@ namespace NS_SLUA {
 		void releaseLink(void* prop);
     	// ͷеpropLink
 		void releaseAllLink();
+		// release props linked to userdata of UObject
+		void releaseObjectLink(GenericUserData* ud, bool detach);
+		// release userdata with object handle, which is stale or collected
+		void releaseObjectHandle(GenericUserData* ud);
+		// track object referenced by lua, removed by swap with last one
+		void addReference(UObject* obj, GenericUserData* ud);
+		void removeReference(const UObject* obj);
+		// run lua gc steps until budget is used up or a cycle is finished
+		void stepGC(double budget);
+		// free objects swept by lua gc on a background task, or wait for pending tasks
+		// ں̨ͷlua gcĶ
+		void dispatchGarbage();
+		void waitGarbage();
+		// track struct pushed to lua, removed by swap with last one
+		void addStruct(LuaStruct* ls);
+		void removeStruct(LuaStruct* ls);
 		// unreal gc will call this funciton
     	// unrealgcʱ
 		void onEngineGC();
@@ -288,25 +404,74 @@ namespace NS_SLUA {
 			typedef TMap<FString, TWeakObjectPtr<UProperty>> CachePropItem;
 			typedef TMap<TWeakObjectPtr<UClass>, CachePropItem> CachePropMap;
 			
+			// member cache keyed by class and address of interned lua string
+			// ָluaڻַַΪkey,ѯֻҪһhash
+			struct MemberKey {
+				UClass* uclass;
+				const char* name;
+				bool operator==(const MemberKey& other) const {
+					return uclass == other.uclass && name == other.name;
+				}
+				friend uint32 GetTypeHash(const MemberKey& key) {
+					return HashCombine(PointerHash(key.uclass), PointerHash(key.name));
+				}
+			};
+			struct MemberItem {
+				// identity of class checked on lookup, key only gives the address
+				TWeakObjectPtr<UClass> uclass;
+				CacheMember member;
+			};
+			typedef TMap<MemberKey, MemberItem> CacheMemberMap;
+
 			UFunction* findFunc(UClass* uclass, const char* fname);
 			UProperty* findProp(UClass* uclass, const char* pname);
+			const CacheMember* findMember(UClass* uclass, const char* name);
 			void cacheFunc(UClass* uclass, const char* fname, UFunction* func);
 			void cacheProp(UClass* uclass, const char* pname, UProperty* prop);
+			void cacheMember(UClass* uclass, const char* name, const CacheMember& member);
 			void clear() {
 				cacheFuncMap.Empty();
 				cachePropMap.Empty();
+				cacheMemberMap.Empty();
 			}
 
 			CacheFuncMap cacheFuncMap;
 			CachePropMap cachePropMap;
+			CacheMemberMap cacheMemberMap;
 		} classMap;
+		// metatables generated for UClass, value is ref in registry
+		// UClassӦԪ
+		TMap<TWeakObjectPtr<UClass>, int> classMetatables;
+		bool classMetatableEnabled;
+		bool structReferenceEnabled;
+		bool objectHandleEnabled;
+		bool poolAllocatorEnabled;
+		LuaPoolAllocator* poolAllocator;
+		// call plan of UFunction, compiled at first call
+		// UFunctionĵüƻ
+		TMap<UFunction*, TUniquePtr<LuaObject::FuncCallPlan>> callPlans;
+
+		// table in registry to keep member names cached by classMap alive
+		// лԱַ,ֹlua gcַ
+		int memberNameRef;
+		void pruneMemberNames();
 
 		FDeadLoopCheck* deadLoopCheck;
 
 		// hold UObjects pushed to lua
 		UObjectRefMap objRefs;
+		// objects with UD_REFERENCE, handed to collector in one call, userdata and key at same index,
+		// userdata is nullptr for objects referenced without userdata such as delegates
+		// luaǿõĶ,
+		TArray<UObject*> refObjects;
+		TArray<GenericUserData*> refUserdatas;
+		TArray<const UObject*> refKeys;
+		TMap<const UObject*, int32> refIndices;
 		// hold FGcObject to defer delete
 		TArray<FGCObject*> deferDelete;
+		// structs pushed to lua, referenced by AddReferencedObjects of LuaState
+		// luaеĽṹ
+		TArray<LuaStruct*> structs;
 		// store UGameInstance ptr to search LuaState
 		// we don't hold referrence
 		UGameInstance* pGI;
@@ -316,6 +481,10 @@ namespace NS_SLUA {
 		FDelegateHandle wcHandler;
 
 		bool enableMultiThreadGC;
+		double gcStepBudget;
+		// tasks freeing garbage detached from lua in multi-thread gc mode
+		FGraphEventArray garbageTasks;
+		LuaGCScheduler gcScheduler;
 		LuaVar stateTickFunc;
 
         static LuaState* mainState;
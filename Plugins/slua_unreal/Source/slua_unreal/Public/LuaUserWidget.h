@@ -53,7 +53,7 @@ public:
 	void superTick() override;
 	void tick(float dt) override;
 
-	virtual NS_SLUA::LuaVar getSelfTable() const {
+	virtual const NS_SLUA::LuaVar& getSelfTable() const {
 		return luaSelfTable;
 	}
 private:
@@ -28,6 +28,23 @@
 
 namespace NS_SLUA {
 
+    // read first return value of LuaVar::callTyped from stack
+    template<class R>
+    struct LuaTypedReturn {
+        // return values are popped before callTyped returns, a string pointer would dangle
+        static_assert(!std::is_same<typename remove_cr<R>::type, const char*>::value && !std::is_same<typename remove_cr<R>::type, char*>::value,
+            "callTyped can't return char pointer, use FString instead");
+        static R read(lua_State* L,int nret) {
+            if(nret<=0) return R();
+            return ArgOperatorOpt::readArg<typename remove_cr<R>::type>(L,-nret);
+        }
+    };
+
+    template<>
+    struct LuaTypedReturn<void> {
+        static void read(lua_State* L,int nret) {}
+    };
+
     class SLUA_UNREAL_API LuaVar {
     public:
         enum Type {LV_NIL,LV_INT,LV_NUMBER,LV_BOOL,
@@ -47,6 +64,7 @@ namespace NS_SLUA {
         LuaVar(lua_State* L,int p,Type t);
 
     	// Ϳ
+    	// copy shares registry reference and string buffer by reference count
         LuaVar(const LuaVar& other):LuaVar() {
             clone(other);
         }
@@ -109,6 +127,7 @@ namespace NS_SLUA {
         int64 asInt64() const;
         float asFloat() const;
         double asDouble() const;
+        // buffer is valid while LuaVar holds the string, state may be closed
         const char* asString(size_t* outlen=nullptr) const;
 		LuaLString asLString() const;
         bool asBool() const;
@@ -130,7 +149,7 @@ namespace NS_SLUA {
         	 * ᷵ظûݵĵַ
         	 */
         	
-            UserData<T*>* ud = reinterpret_cast<UserData<T*>*>(luaL_testudata(L, -1, t));
+            UserData<T*>* ud = reinterpret_cast<UserData<T*>*>(LuaObject::testUserdata(L, -1, t));
             lua_pop(L,1);
             return ud?ud->ud:nullptr;
         }
@@ -279,6 +298,23 @@ namespace NS_SLUA {
             return ret.castTo<RET>();
         }
 
+        // call function and read first return value from stack as R directly,
+        // no LuaVar is created for return values, R could be void
+        // ֱӴջ϶ȡֵ,LuaVar
+        template<class R,class ...ARGS>
+        R callTyped(ARGS&& ...args) const {
+            if(!isFunction() || !isValid()) {
+                Log::Error("LuaVar is not a valid function, can't be called");
+                return LuaTypedReturn<R>::read(nullptr,0);
+            }
+            auto L = getState();
+            // return values are popped after read
+            AutoStack as(L);
+            int n = pushArg(std::forward<ARGS>(args)...);
+            int nret = docall(n);
+            return LuaTypedReturn<R>::read(L,nret);
+        }
+
     	// Ǳ,Ȼcallһ
     	// a.b(...)
 		template<class ...ARGS>
@@ -308,7 +344,13 @@ namespace NS_SLUA {
 		// LuaֵõProperty
         bool toProperty(UProperty* p,uint8* ptr);
 		// UFunction
+		// this isn't read after the function is pushed, so the var may be reassigned during the call
         bool callByUFunction(UFunction* ufunc,uint8* parms,LuaVar* pSelf = nullptr,FOutParmRec* OutParms = nullptr);
+        // push arguments of ufunc except out params, return count of pushed values
+        // ѹUFunction
+        static int pushParms(lua_State* L,UFunction* ufunc,uint8* parms);
+        // call with argn arguments on stack, fill return value and out params of ufunc from results
+        bool callWithParms(UFunction* ufunc,uint8* parms,int argn,FOutParmRec* OutParms = nullptr);
 
 		// get associate state
 		lua_State* getState() const;
@@ -327,56 +369,24 @@ namespace NS_SLUA {
     	// ռ,ʵָ鳤
         void alloc(int n);
 
-    	// 
-        struct Ref {
-            Ref():refCount(1) {}
-            virtual ~Ref() {}
-            void addRef() {
-				refCount++;
-            }
-            void release() {
-                ensure(refCount >0);
-            	// ÿ--,һ,ôΪ0ʱ,ͷ
-                if(--refCount ==0) {
-                    delete this;
-                }
-            }
-            int refCount;
-        };
-
-    	// ַ
-    	// ַʹҪÿοһͬСĿռ
-        struct RefStr : public Ref {
-			RefStr(const char* s, size_t len)
-				:Ref()
-            {
-				if (len == 0) len = strlen(s);
-				// alloc extra space for '\0'
-				// Ϊ'\0' ࿪һռ
-				buf = (char*) FMemory::Malloc(len+1);
-				FMemory::Memcpy(buf, s, len);
-				buf[len] = 0;
-				length = len;
-			}
-            virtual ~RefStr() {
-                FMemory::Free(buf);
-            }
-            char* buf;
-			size_t length;
+        // registry reference shared by copies of LuaVar, dropped when last copy is freed
+        // 乲ע,ü
+        struct SharedRef {
+            int32 refCount;
+            int32 ref;
+            static SharedRef* create(lua_State* L, int p);
         };
 
-    	// ø
-        struct RefRef: public Ref {
-            RefRef(lua_State* l);
-            virtual ~RefRef();
-            bool isValid() {
-                return ref != LUA_NOREF;
+    	// string copied from lua or c string, chars with '\0' follow it in same block,
+    	// long string from lua is referenced too, so push to its state needn't hash it again
+    	// ַ,ֻһ,luaַͬʱ
+        struct StrBuf : SharedRef {
+            size_t length;
+            char* buf() {
+                return (char*)(this+1);
             }
-            void push(lua_State* l) {
-                lua_geti(l,LUA_REGISTRYINDEX,ref);
-            }
-            int ref;
-            int stateIndex;
+            static StrBuf* create(const char* s, size_t len);
+            static StrBuf* create(lua_State* L, int p);
         };
 
         int stateIndex;
@@ -384,18 +394,22 @@ namespace NS_SLUA {
         typedef struct {
         	// ,ܴڵͶӦֵ
             union {
-                RefRef* ref;
+                // registry reference of function, table or userdata
+                // ע,乲
+                SharedRef* ref;
                 lua_Integer i;
                 lua_Number d;
-                RefStr* s;
+                StrBuf* s;
                 void* ptr;
                 bool b;
             };
             Type luatype;
         } lua_var;
 
+        // points to inlineVar if there is only one value
         lua_var* vars;
         size_t numOfVar;
+        lua_var inlineVar;
 
     	// ,Բͳ
         template<class F,class ...ARGS>
@@ -422,8 +436,6 @@ namespace NS_SLUA {
 
     	// 
         int docall(int argn) const;
-    	// UFunctionLuaState
-        int pushArgByParms(UProperty* prop,uint8* parms);
 
     	// 캯
         void clone(const LuaVar& other);
@@ -431,8 +443,15 @@ namespace NS_SLUA {
         void move(LuaVar&& other);
     	// ֵ
         void varClone(lua_var& tv,const lua_var& ov) const;
+        // value is kept by registry reference
+        static bool hasRef(const lua_var& v) {
+            return v.luatype==LV_FUNCTION || v.luatype==LV_TABLE || v.luatype==LV_USERDATA;
+        }
+        // release a reference of copies, unref it from registry by last one
+        void release(SharedRef* r) const;
     	// ֵѹջ
-        void pushVar(lua_State* l,const lua_var& ov) const;
+        // registry of l is read only if owner is true, which means l belongs to state of LuaVar
+        void pushVar(lua_State* l,const lua_var& ov,bool owner) const;
     };
 
 	// ֵ
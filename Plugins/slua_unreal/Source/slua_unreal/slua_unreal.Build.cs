@@ -25,7 +25,6 @@ public class slua_unreal : ModuleRules
         bEnableUndefinedIdentifierWarnings = false;
 
         var externalSource = Path.Combine(ModuleDirectory, "../../External");
-        var externalLib = Path.Combine(ModuleDirectory, "../../Library");
 
         PublicIncludePaths.AddRange(
             new string[] {
@@ -35,38 +34,17 @@ public class slua_unreal : ModuleRules
 			}
             );
 
-        if (Target.Platform == UnrealTargetPlatform.IOS)
-        {
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "iOS"));
-            PublicAdditionalLibraries.Add("lua");
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Android)
-        {
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Android/armeabi-arm64"));
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Android/armeabi-v7a"));
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Android/x86"));
-            PublicAdditionalLibraries.Add("lua");
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Win32 )
-        {
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Win32"));
-            PublicAdditionalLibraries.Add("lua.lib");
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Win64)
-        {
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Win64"));
-            PublicAdditionalLibraries.Add("lua.lib");
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Mac)
-        {
-            // Unreal ignores PublicLibraryPaths on Mac. But why? 
-            // PublicLibraryPaths.Add(Path.Combine(externalLib, "Mac"));
-            PublicAdditionalLibraries.Add(Path.Combine(externalLib, "Mac/liblua.a"));
-        }
-        else if (Target.Platform == UnrealTargetPlatform.Linux)
+        // lua and luasocket are compiled into the module by LuaVM.cpp and LuaSocketLib.cpp,
+        // their file scope statics and macros must not be merged into unity files
+#if UE_4_22_OR_LATER
+        bUseUnity = false;
+#else
+        bFasterWithoutUnity = true;
+#endif
+        // luasocket of windows
+        if (Target.Platform == UnrealTargetPlatform.Win32 || Target.Platform == UnrealTargetPlatform.Win64)
         {
-            PublicLibraryPaths.Add(Path.Combine(externalLib, "Linux"));
-            PublicAdditionalLibraries.Add("lua");
+            PublicAdditionalLibraries.Add("ws2_32.lib");
         }
 
     PublicDependencyModuleNames.AddRange(
@@ -26,7 +26,29 @@ static uint8* ReadFile(IPlatformFile& PlatformFile, FString path, uint32& len) {
 	return nullptr;
 }
 
-UMyGameInstance::UMyGameInstance() :state("main",this) {
+// load lua file from Content/Lua
+static uint8* LoadLuaFile(const char* fn, uint32& len, FString& filepath) {
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FString path = FPaths::ProjectContentDir();
+	FString filename = UTF8_TO_TCHAR(fn);
+	path /= "Lua";
+	path /= filename.Replace(TEXT("."), TEXT("/"));
+
+	TArray<FString> luaExts = { UTF8_TO_TCHAR(".lua"), UTF8_TO_TCHAR(".luac") };
+	for (auto& it : luaExts) {
+		auto fullPath = path + *it;
+		auto buf = ReadFile(PlatformFile, fullPath, len);
+		if (buf) {
+			fullPath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*fullPath);
+			filepath = fullPath;
+			return buf;
+		}
+	}
+
+	return nullptr;
+}
+
+UMyGameInstance::UMyGameInstance() :state("main",this), optionState("option") {
 
 }
 
@@ -35,31 +57,19 @@ void UMyGameInstance::Init()
 	state.onInitEvent.AddUObject(this, &UMyGameInstance::LuaStateInitCallback);
 	state.init();
 
-	state.setLoadFileDelegate([](const char* fn, uint32& len, FString& filepath)->uint8* {
-
-		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-		FString path = FPaths::ProjectContentDir();
-		FString filename = UTF8_TO_TCHAR(fn);
-		path /= "Lua";
-		path /= filename.Replace(TEXT("."), TEXT("/"));
-
-		TArray<FString> luaExts = { UTF8_TO_TCHAR(".lua"), UTF8_TO_TCHAR(".luac") };
-		for (auto& it : luaExts) {
-			auto fullPath = path + *it;
-			auto buf = ReadFile(PlatformFile, fullPath, len);
-			if (buf) {
-				fullPath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*fullPath);
-				filepath = fullPath;
-				return buf;
-			}
-		}
+	state.setLoadFileDelegate(&LoadLuaFile);
 
-		return nullptr;
-	});
+	// deleted UObject is detected by handle instead of delete listener
+	optionState.enableObjectHandle(true);
+	// small blocks come from pools of the state, freed by gc thread if threadGC is on
+	optionState.enablePoolAllocator(true);
+	optionState.init();
+	optionState.setLoadFileDelegate(&LoadLuaFile);
 }
 
 void UMyGameInstance::Shutdown()
 {
+	optionState.close();
 	state.close();
 }
 
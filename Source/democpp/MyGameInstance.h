@@ -28,4 +28,6 @@ public:
 
 	// create global state, freed on app exit
 	NS_SLUA::LuaState state;
+	// state with options which must be set before init, runs TestOption.lua
+	NS_SLUA::LuaState optionState;
 };
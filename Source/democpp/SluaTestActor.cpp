@@ -25,6 +25,9 @@ void ASluaTestActor::BeginPlay()
 	ls->doFile("Test");
 	ls->set("some.field.z", 104);
 	ls->call("begin",this->GetWorld(),this);
+
+	NS_SLUA::LuaState* os = NS_SLUA::LuaState::get(FString("option"));
+	os->doFile("TestOption");
 }
 
 // Called every frame
@@ -35,6 +38,8 @@ void ASluaTestActor::Tick(float DeltaTime)
 
 	NS_SLUA::LuaState* ls = NS_SLUA::LuaState::get(GetGameInstance());
 	ls->call("update",DeltaTime);
+	NS_SLUA::LuaState* os = NS_SLUA::LuaState::get(FString("option"));
+	os->call("update",DeltaTime);
 
 	PROFILER_WATCHER_X(w2,"UE ForceGarbageCollection");
 	GEngine->ForceGarbageCollection(true);
@@ -319,6 +319,54 @@ namespace NS_SLUA {
 		DefLuaMethod(GetHttpTimeout, &FHttpModule::GetHttpTimeout)
 
 	EndDef(FHttpModule,nullptr)
+
+	// benchmark param marshalling of UFunction, by reflection iteration and by call plan
+	// usage: t:BenchCallPlan(funcName, count, args...), return time of both
+	static int BenchCallPlan(lua_State* L) {
+		CheckUD(USluaTestCase, L, 1);
+		const char* fname = LuaObject::checkValue<const char*>(L, 2);
+		int count = LuaObject::checkValue<int>(L, 3);
+		UFunction* func = UD->FindFunction(FName(UTF8_TO_TCHAR(fname)));
+		if (!func) luaL_error(L, "can't find function %s", fname);
+		int top = lua_gettop(L);
+
+		double start = FPlatformTime::Seconds();
+		for (int i = 0; i < count; i++) {
+			FuncParamsScope params(func);
+			LuaObject::fillParam(L, 4, func, params.get());
+			UD->ProcessEvent(func, params.get());
+			LuaObject::returnValue(L, func, params.get());
+			lua_settop(L, top);
+		}
+		double reflectionTime = FPlatformTime::Seconds() - start;
+
+		start = FPlatformTime::Seconds();
+		for (int i = 0; i < count; i++) {
+			auto plan = LuaObject::getCallPlan(L, func);
+			FuncParamsScope params(func, plan->needInit, plan->needDestroy);
+			LuaObject::fillParam(L, 4, plan, params.get());
+			UD->ProcessEvent(func, params.get());
+			LuaObject::returnValue(L, plan, params.get());
+			lua_settop(L, top);
+		}
+		double callPlanTime = FPlatformTime::Seconds() - start;
+
+		LuaObject::push(L, reflectionTime);
+		LuaObject::push(L, callPlanTime);
+		return 2;
+	}
+
+	// switch class metatable of calling state, usage: SluaTestCase.EnableClassMetatable(true)
+	static int EnableClassMetatable(lua_State* L) {
+		LuaState::get(L)->enableClassMetatable(!!lua_toboolean(L, 1));
+		return 0;
+	}
+
+	// switch struct reference of calling state, usage: SluaTestCase.EnableStructReference(true)
+	static int EnableStructReference(lua_State* L) {
+		LuaState::get(L)->enableStructReference(!!lua_toboolean(L, 1));
+		return 0;
+	}
 }
 
 UTestObject::UTestObject(const FObjectInitializer& ObjectInitializer)
@@ -340,6 +388,9 @@ USluaTestCase::USluaTestCase(const FObjectInitializer& ObjectInitializer)
     });  
     REG_EXTENSION_METHOD(USluaTestCase, "constRetFunc", &USluaTestCase::constRetFunc);
 	REG_EXTENSION_METHOD(USluaTestCase, "inlineFunc", &USluaTestCase::inlineFunc);
+	LuaObject::addExtensionMethod(USluaTestCase::StaticClass(), "BenchCallPlan", BenchCallPlan);
+	LuaObject::addExtensionMethod(USluaTestCase::StaticClass(), "EnableClassMetatable", EnableClassMetatable, true);
+	LuaObject::addExtensionMethod(USluaTestCase::StaticClass(), "EnableStructReference", EnableStructReference, true);
 
 	info.obj = this;
 	info.name = UTF8_TO_TCHAR("女战士");
@@ -476,6 +527,14 @@ int USluaTestCase::FuncWithStr(FString str) {
     return str.Len();
 }
 
+int USluaTestCase::FuncWith4Args(int a, int b, int c, int d) {
+    return a + b + c + d;
+}
+
+int USluaTestCase::FuncWith8Args(int a, int b, int c, int d, int e, int f, int g, int h) {
+    return a + b + c + d + e + f + g + h;
+}
+
 void USluaTestCase::TestUnicastDelegate(FString str)
 {
     int32 retVal = OnTestGetCount.IsBound() ? OnTestGetCount.Execute(str) : -1;
@@ -89,6 +89,9 @@ public:
     UPROPERTY(BlueprintReadWrite)
     TArray<FString> strs;
 
+    UPROPERTY(BlueprintReadWrite)
+    TSet<FString> sets;
+
 	UPROPERTY(BlueprintReadWrite)
 	TMap<int,FUserInfo> userInfo;
 
@@ -173,6 +176,12 @@ public:
     UFUNCTION(BlueprintCallable, Category="Lua|TestCase")
     int FuncWithStr(FString str);
 
+    UFUNCTION(BlueprintCallable, Category="Lua|TestCase")
+    int FuncWith4Args(int a, int b, int c, int d);
+
+    UFUNCTION(BlueprintCallable, Category="Lua|TestCase")
+    int FuncWith8Args(int a, int b, int c, int d, int e, int f, int g, int h);
+
     const USluaTestCase* constRetFunc() { return nullptr; }
 
 	FORCEINLINE int inlineFunc() { return 1; }
@@ -198,6 +207,12 @@ public:
 		OnTestAAA.Broadcast(str);
 	}
 
+	UFUNCTION(BlueprintCallable, Category = "Lua|TestCase")
+		bool IsAAABound() const
+	{
+		return OnTestAAA.IsBound();
+	}
+
 	UFUNCTION()
 	void TestLuaCallback(FLuaBPVar callback) {
 		if (callback.value.isFunction())